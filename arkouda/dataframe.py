@@ -4,7 +4,7 @@ import json
 import os
 import random
 from collections import UserDict
-from typing import Callable, Dict, List, Optional, Union, cast
+from typing import Callable, Dict, List, Mapping, Optional, Union, cast
 from warnings import warn
 
 import numpy as np  # type: ignore
@@ -1826,8 +1826,12 @@ class DataFrame(UserDict):
         path,
         index=False,
         columns=None,
-        compression: Optional[str] = None,
+        compression: Optional[Union[str, Mapping[str, str]]] = None,
         convert_categoricals: bool = False,
+        encoding: Optional[Union[str, Mapping[str, str]]] = None,
+        statistics: Union[bool, Mapping[str, bool]] = True,
+        page_index: Union[bool, Mapping[str, bool]] = False,
+        sorting_columns: Optional[List[str]] = None,
     ):
         """
         Save DataFrame to disk as parquet, preserving column names.
@@ -1844,11 +1848,29 @@ class DataFrame(UserDict):
             Default None
             Provide the compression type to use when writing the file.
             Supported values: snappy, gzip, brotli, zstd, lz4
+            A dict maps column names to the compression of that column.
         convert_categoricals: bool
             Defaults to False
             Parquet requires all columns to be the same size and Categoricals
             don't satisfy that requirement.
             if set, write the equivalent Strings in place of any Categorical columns.
+        encoding : str or dict of str (Optional)
+            Default None
+            The encoding of the columns, or a dict mapping column names to the
+            encoding of that column. See ak.to_parquet for the supported values.
+        statistics : bool or dict of bool
+            Default True
+            Write min/max/null count statistics for the columns, or for the
+            columns a dict maps to True.
+        page_index : bool or dict of bool
+            Default False
+            Write column and offset indexes for the columns, or for the
+            columns a dict maps to True. Requires a server built with
+            Arrow 12 or later.
+        sorting_columns : list of str (Optional)
+            Names of the columns the DataFrame is sorted by, recorded in the
+            file metadata as a hint for readers. Requires a server built
+            with Arrow 13 or later.
         Returns
         -------
         None
@@ -1875,7 +1897,14 @@ class DataFrame(UserDict):
                 "set to True."
             )
         to_parquet(
-            data, prefix_path=path, compression=compression, convert_categoricals=convert_categoricals
+            data,
+            prefix_path=path,
+            compression=compression,
+            convert_categoricals=convert_categoricals,
+            encoding=encoding,
+            statistics=statistics,
+            page_index=page_index,
+            sorting_columns=sorting_columns,
         )
 
     @typechecked
@@ -564,7 +564,8 @@ class Index:
         have write permission.
         - Output files have names of the form ``<prefix_path>_LOCALE<i>``, where ``<i>``
         ranges from 0 to ``numLocales`` for `file_type='distribute'`.
-        - 'append' write mode is supported, but is not efficient.
+        - 'append' write mode is supported. Columns already in the files are
+        copied over as is rather than being decoded and rewritten.
         - If any of the output files already exist and
         the mode is 'truncate', they will be overwritten. If the mode is 'append'
         and the number of output files is less than the number of locales or a
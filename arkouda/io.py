@@ -1,9 +1,10 @@
 import glob
 import json
 import os
-from typing import Dict, List, Mapping, Optional, Union, cast
+from typing import Any, Dict, List, Mapping, Optional, Set, Tuple, Union, cast
 from warnings import warn
 
+import numpy as np  # type: ignore
 import pandas as pd  # type: ignore
 from typeguard import typechecked
 
@@ -25,6 +26,7 @@ __all__ = [
     "ls",
     "ls_csv",
     "get_null_indices",
+    "get_decimal_scales",
     "get_datasets",
     "get_columns",
     "read_hdf",
@@ -193,6 +195,44 @@ def get_null_indices(
     return _build_objects(rep)  # type: ignore
 
 
+def get_decimal_scales(filename: str, datasets: Union[str, List[str]]) -> Dict[str, int]:
+    """
+    Get the scale of decimal columns in a Parquet file.
+
+    Decimal columns are read as their unscaled integer values, an int64
+    pdarray for a precision up to 18 and a bigint pdarray beyond that. The
+    value of a decimal is its unscaled value divided by ``10**scale``.
+
+    Parameters
+    ----------
+    filename : str
+        Either a filename or shell expression, the first matching file is used
+    datasets : list or str
+        (List of) name(s) of decimal dataset(s)
+
+    Returns
+    -------
+    Dict[str, int]
+        Dictionary of {datasetName: scale}
+
+    Raises
+    ------
+    RuntimeError
+        Raised if the file cannot be opened or a dataset is not a decimal column
+
+    See Also
+    --------
+    read_parquet
+    """
+    if isinstance(datasets, str):
+        datasets = [datasets]
+    rep_msg = generic_msg(
+        cmd="decimalscalesparquet",
+        args={"filename": filename, "dset_size": len(datasets), "dsets": datasets},
+    )
+    return {name: int(scale) for name, scale in json.loads(cast(str, rep_msg)).items()}
+
+
 @typechecked
 def _file_type_to_int(file_type: str) -> int:
     """
@@ -755,6 +795,61 @@ def read_hdf(
         return _build_objects(rep)
 
 
+def _filter_value(value: Any) -> Any:
+    """
+    Time values are filtered as the int64 nanoseconds they are read as
+    """
+    if isinstance(value, (pd.Timestamp, np.datetime64)):
+        return pd.Timestamp(value).value
+    if isinstance(value, (pd.Timedelta, np.timedelta64)):
+        return pd.Timedelta(value).value
+    return value
+
+
+def _parquet_filter_args(
+    filters: Optional[Dict[str, Union[Tuple[Any, Any], List[Any], Set[Any]]]]
+) -> Dict[str, Any]:
+    """
+    Convert the filters passed to read_parquet into the arguments of the
+    readAllParquet message, a kind and a list of values per dataset
+    """
+    if not filters:
+        return {}
+    cols, kinds, num_values, values = [], [], [], []
+    for col, cond in filters.items():
+        if isinstance(cond, tuple):
+            if len(cond) != 2:
+                raise ValueError(f"Range filter on {col} must be a (low, high) tuple")
+            low, high = cond
+            if low is None and high is None:
+                continue
+            if high is None:
+                kind, vals = "min", [low]
+            elif low is None:
+                kind, vals = "max", [high]
+            else:
+                kind, vals = "range", [low, high]
+        elif isinstance(cond, (list, set)):
+            kind, vals = "in", list(cond)
+        else:
+            raise TypeError(f"Filter on {col} must be a (low, high) tuple, list or set")
+        cols.append(col)
+        kinds.append(kind)
+        num_values.append(len(vals))
+        values.extend(str(_filter_value(v)) for v in vals)
+    if not cols:
+        return {}
+    args: Dict[str, Any] = {
+        "filter_size": len(cols),
+        "filter_cols": cols,
+        "filter_kinds": kinds,
+        "filter_num_values": num_values,
+    }
+    if values:
+        args["filter_values"] = values
+    return args
+
+
 def read_parquet(
     filenames: Union[str, List[str]],
     datasets: Optional[Union[str, List[str]]] = None,
@@ -763,6 +858,9 @@ def read_parquet(
     allow_errors: bool = False,
     tag_data: bool = False,
     read_nested: bool = True,
+    categorical_strings: bool = False,
+    filters: Optional[Dict[str, Union[Tuple[Any, Any], List[Any], Set[Any]]]] = None,
+    validity: bool = False,
 ) -> Union[
     pdarray,
     Strings,
@@ -819,6 +917,29 @@ def read_parquet(
         Default True, when True, SegArray objects will be read from the file. When False,
         SegArray (or other nested Parquet columns) will be ignored.
         If datasets is not None, this will be ignored.
+    categorical_strings: bool
+        Default False, if True string datasets that are dictionary encoded in every
+        file are read as Categorical objects built directly from the stored
+        dictionaries, without expanding every string. Nulls are read as the
+        Categorical's NA value. Other string datasets are still read as Strings.
+    filters: Optional dict
+        Default None, maps dataset names to a condition on the dataset's values.
+        A condition is either a ``(low, high)`` tuple for an inclusive range,
+        where either bound may be None, or a list or set of values to match.
+        Row groups whose statistics show they hold no row meeting every
+        condition are not read. When a file has a page index, its pages are
+        pruned the same way, if the server is built with Arrow 12 or later.
+        This only narrows down the rows read, the rows returned can
+        still include rows that do not meet the conditions. Conditions on
+        timestamp, date and duration datasets are in nanoseconds, the unit
+        they are read as, and may also be given as Timestamps or Timedeltas.
+        Not supported when reading SegArray datasets.
+    validity: bool
+        Default False, if True every numeric, bool and Strings dataset is
+        returned along with a bool pdarray named ``<dataset>_validity`` that is
+        True where the row is not null. It is decoded in the same pass as the
+        values, so nulls read as NaN, 0, False or "" can be told apart from
+        real values without reading the files again.
 
     Returns
     -------
@@ -854,6 +975,14 @@ def read_parquet(
     and read all of them. Use ``get_datasets`` to show the names of datasets
     to Parquet files.
 
+    Decimal datasets are read as their unscaled integer values, as int64 up
+    to a precision of 18 and as bigint beyond that, so no digits are lost.
+    Use ``get_decimal_scales`` to get the scale to divide them by.
+
+    Timestamp and date datasets are read as Datetime and duration datasets
+    as Timedelta, converted to nanoseconds from whatever unit the file stores
+    them in. Timezone aware timestamps are returned in UTC.
+
     Parquet always recomputes offsets at this time
     This will need to be updated once parquets workflow is updated
 
@@ -875,6 +1004,21 @@ def read_parquet(
     if iterative:
         if tag_data:
             raise RuntimeError("Cannot tag data with iterative read.")
+        if validity:
+            objs: Dict[str, Any] = {}
+            for dset in datasets:
+                rd = read_parquet(
+                    filenames,
+                    datasets=dset,
+                    strict_types=strict_types,
+                    allow_errors=allow_errors,
+                    read_nested=read_nested,
+                    categorical_strings=categorical_strings,
+                    filters=filters,
+                    validity=validity,
+                )
+                objs.update(rd if isinstance(rd, dict) else {dset: rd})
+            return objs
         return {
             dset: read_parquet(
                 filenames,
@@ -883,6 +1027,8 @@ def read_parquet(
                 allow_errors=allow_errors,
                 tag_data=tag_data,
                 read_nested=read_nested,
+                categorical_strings=categorical_strings,
+                filters=filters,
             )[dset]
             for dset in datasets
         }
@@ -897,6 +1043,9 @@ def read_parquet(
                 "dsets": datasets,
                 "filenames": filenames,
                 "tag_data": tag_data,
+                "categorical_strings": categorical_strings,
+                "validity": validity,
+                **_parquet_filter_args(filters),
             },
         )
         rep = json.loads(rep_msg)  # See GenSymIO._buildReadAllMsgJson for json structure
@@ -1196,6 +1345,26 @@ def _bulk_write_prep(
     return datasetNames, data, col_objtypes
 
 
+# statistics flags of a Parquet column, see ArrowFunctions.h
+_STATS_MINMAX = 1
+_STATS_PAGE_INDEX = 2
+
+
+def _parquet_column_options(option: Any, names: List[str], default: Any) -> List[Any]:
+    """
+    Expands a write option given for all columns, or as a dict keyed by
+    column name, to one value per column
+    """
+    if option is None:
+        return [default] * len(names)
+    if not isinstance(option, Mapping):
+        return [option] * len(names)
+    unknown = set(option.keys()) - set(names)
+    if unknown:
+        raise ValueError(f"Columns {sorted(unknown)} are not being written")
+    return [option.get(name, default) for name in names]
+
+
 def to_parquet(
     columns: Union[
         Mapping[str, Union[pdarray, Strings, SegArray, ArrayView]],
@@ -1204,8 +1373,12 @@ def to_parquet(
     prefix_path: str,
     names: List[str] = None,
     mode: str = "truncate",
-    compression: Optional[str] = None,
+    compression: Optional[Union[str, Mapping[str, str]]] = None,
     convert_categoricals: bool = False,
+    encoding: Optional[Union[str, Mapping[str, str]]] = None,
+    statistics: Union[bool, Mapping[str, bool]] = True,
+    page_index: Union[bool, Mapping[str, bool]] = False,
+    sorting_columns: Optional[List[str]] = None,
 ) -> None:
     """
     Save multiple named pdarrays to Parquet files.
@@ -1222,15 +1395,49 @@ def to_parquet(
         By default, truncate (overwrite) the output files if they exist.
         If 'append', attempt to create new dataset in existing files.
         'append' is deprecated, please use the multi-column write
-    compression : str (Optional)
+        Appending keeps the file's metadata and sorting columns, but files
+        written with a page index can't be appended to.
+    compression : str or dict of str (Optional)
             Default None
             Provide the compression type to use when writing the file.
-            Supported values: snappy, gzip, brotli, zstd, lz4
+            Supported values: snappy, gzip, brotli, zstd, lz4, and none
+            A dict maps column names to the compression of that column,
+            columns that aren't in it are not compressed. Columns without a
+            compression are compressed with zstd when auto encoding picks
+            byte_stream_split for them; give "none" (or None in the dict)
+            to keep them uncompressed.
         convert_categoricals: bool
             Defaults to False
             Parquet requires all columns to be the same size and Categoricals
             don't satisfy that requirement.
             if set, write the equivalent Strings in place of any Categorical columns.
+    encoding : str or dict of str (Optional)
+            Default None
+            The encoding of the columns, or a dict mapping column names to
+            the encoding of that column. Supported values:
+            default (dictionary, falling back to plain), plain, dictionary,
+            delta (int64 and uint64 only), byte_stream_split (float64 only)
+            and auto, which samples each column's values: sorted integers
+            use delta, floats use byte_stream_split with zstd compression
+            unless a compression was given, and strings use dictionary
+            encoding only when the sample has few distinct values.
+            Not supported with 'append' mode.
+    statistics : bool or dict of bool
+            Default True
+            Write the min, max and null count of every row group and page
+            of the columns, or of the columns a dict maps to True.
+    page_index : bool or dict of bool
+            Default False
+            Write a column index and offset index for the columns, or for
+            the columns a dict maps to True, so readers can skip pages.
+            Requires a server built with Arrow 12 or later, which
+            otherwise raises an error.
+    sorting_columns : list of str (Optional)
+            Names of pdarray columns the files are sorted by, in sort key
+            order. They are recorded in the file metadata so readers can
+            prune sorted outputs cheaply. The server checks that each
+            locale's part of the columns is sorted. Requires a server built
+            with Arrow 13 or later, which otherwise raises an error.
 
     Returns
     -------
@@ -1239,8 +1446,10 @@ def to_parquet(
     Raises
     ------
     ValueError
-        Raised if (1) the lengths of columns and values differ or (2) the mode
-        is not 'truncate' or 'append'
+        Raised if (1) the lengths of columns and values differ, (2) the mode
+        is not 'truncate' or 'append', (3) an option is given for a column
+        that isn't written or (4) per-column compression, encoding or
+        statistics options are used with 'append'
     RuntimeError
             Raised if a server-side error is thrown saving the pdarray
 
@@ -1279,8 +1488,34 @@ def to_parquet(
         )
 
     datasetNames, data, col_objtypes = _bulk_write_prep(columns, names, convert_categoricals)
+    # "unset" lets auto encoding pick a codec, while None is an explicit "none"
+    col_compressions = [
+        str(c) for c in _parquet_column_options(compression, datasetNames, "unset")
+    ]
+    col_encodings = _parquet_column_options(encoding, datasetNames, "default")
+    stats_flags = [
+        (_STATS_MINMAX if minmax else 0) | (_STATS_PAGE_INDEX if index else 0)
+        for minmax, index in zip(
+            _parquet_column_options(statistics, datasetNames, True),
+            _parquet_column_options(page_index, datasetNames, False),
+        )
+    ]
+    sorting = [] if sorting_columns is None else sorting_columns
+    if set(sorting) - set(datasetNames):
+        raise ValueError(f"Columns {sorted(set(sorting) - set(datasetNames))} are not being written")
+    per_column = (
+        isinstance(compression, Mapping)
+        or encoding is not None
+        or statistics is not True
+        or page_index is not False
+        or len(sorting) > 0
+    )
+    if mode.lower() == "append" and per_column:
+        raise ValueError(
+            "Per-column compression, encoding and statistics are not supported with 'append'"
+        )
     # append or single column use the old logic
-    if mode.lower() == "append" or len(data) == 1:
+    if mode.lower() == "append" or (len(data) == 1 and not per_column):
         for arr, name in zip(data, cast(List[str], datasetNames)):
             arr.to_parquet(prefix_path=prefix_path, dataset=name, mode=mode, compression=compression)
     else:
@@ -1295,7 +1530,11 @@ def to_parquet(
                         "col_objtypes": col_objtypes,
                         "filename": prefix_path,
                         "num_cols": len(data),
-                        "compression": compression,
+                        "col_compressions": col_compressions,
+                        "col_encodings": col_encodings,
+                        "col_stats": stats_flags,
+                        "sorting_size": len(sorting),
+                        "sorting_cols": [datasetNames.index(name) for name in sorting],
                     },
                 ),
             )
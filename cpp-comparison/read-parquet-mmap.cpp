@@ -0,0 +1,62 @@
+#include "read-parquet.h"
+
+// Compares reading int64 columns with pread (what Arkouda does by
+// default) against memory mapping the file, which is what
+// ARKOUDA_SERVER_PARQUET_MEMORY_MAP=1 does for files on local disks.
+// Every read is repeated, the later ones are what a user rereading a
+// file in an interactive session sees, with the file in the page cache.
+
+int64_t readColumns(std::string filename, std::string colname, int num_cols,
+                    int64_t* arr, int64_t batchSize, bool memoryMap) {
+  std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
+    parquet::ParquetFileReader::OpenFile(filename, memoryMap);
+  std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+  const int64_t numElems = file_metadata->num_rows();
+
+  int64_t total = 0;
+  for(int c = 1; c <= num_cols; c++) {
+    auto idx = file_metadata->schema()->ColumnIndex(colname + std::to_string(c));
+    int64_t i = 0;
+    for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+      std::shared_ptr<parquet::ColumnReader> column_reader = parquet_reader->RowGroup(r)->Column(idx);
+      parquet::Int64Reader* reader = static_cast<parquet::Int64Reader*>(column_reader.get());
+      int64_t values_read = 0;
+      while (reader->HasNext() && i < numElems) {
+        (void)reader->ReadBatch(std::min(batchSize, numElems - i), nullptr, nullptr, &arr[i], &values_read);
+        i += values_read;
+      }
+    }
+    total += i;
+  }
+  return total;
+}
+
+int main(int argc, char** argv) {
+  if(argc < 5) {
+    std::cout << "Usage: " << argv[0] << " <filename> <base column name> <batch size> <number of columns> [repetitions]\n";
+    return 1;
+  }
+  std::string filename = argv[1];
+  std::string colname = argv[2];
+  int64_t batchSize = atoi(argv[3]);
+  int num_cols = atoi(argv[4]);
+  int reps = argc > 5 ? atoi(argv[5]) : 5;
+
+  const int64_t numElems = parquet::ParquetFileReader::OpenFile(filename, false)->metadata()->num_rows();
+  int64_t* arr = (int64_t*)malloc(numElems*sizeof(int64_t));
+
+  for(bool memoryMap : {false, true}) {
+    std::cout << "Reading " << num_cols << " columns " << (memoryMap ? "memory mapped: " : "with pread:     ");
+    for(int r = 0; r < reps; r++) {
+      auto start = std::chrono::high_resolution_clock::now();
+      readColumns(filename, colname, num_cols, arr, batchSize, memoryMap);
+      auto finish = std::chrono::high_resolution_clock::now();
+      auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(finish-start);
+      std::cout << milliseconds.count()/1000.0 << "s ";
+    }
+    std::cout << "\n";
+  }
+
+  free(arr);
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <iostream>
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/column_reader.h>
+#include <parquet/api/writer.h>
+#include <parquet/schema.h>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <chrono>
+#include "read-parquet.h"
+
+// Compares the two ways Arkouda has read the values of a list of strings
+// column (a SegArray of strings) into null terminated bytes: one value
+// per ReadBatch call, and batches of batchSize values, which is what
+// cpp_readListColumnByName does now.
+
+int64_t readOneAtATime(std::string filename, std::string colname, unsigned char* chpl_ptr) {
+  std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
+    parquet::ParquetFileReader::OpenFile(filename, false);
+  std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+  auto idx = file_metadata->schema()->group_node()->FieldIndex(colname);
+  int16_t max_def = file_metadata->schema()->Column(idx)->max_definition_level();
+
+  int64_t i = 0;
+  for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+    std::shared_ptr<parquet::ColumnReader> column_reader = parquet_reader->RowGroup(r)->Column(idx);
+    parquet::ByteArrayReader* reader = static_cast<parquet::ByteArrayReader*>(column_reader.get());
+    while (reader->HasNext()) {
+      int16_t definition_level;
+      int64_t values_read = 0;
+      parquet::ByteArray value;
+      (void)reader->ReadBatch(1, &definition_level, nullptr, &value, &values_read);
+      if(values_read > 0 && definition_level == max_def) {
+        memcpy(&chpl_ptr[i], value.ptr, value.len);
+        i += value.len + 1;
+      }
+    }
+  }
+  return i;
+}
+
+int64_t readBatched(std::string filename, std::string colname, unsigned char* chpl_ptr, int64_t batchSize) {
+  std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
+    parquet::ParquetFileReader::OpenFile(filename, false);
+  std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+  auto idx = file_metadata->schema()->group_node()->FieldIndex(colname);
+  int16_t max_def = file_metadata->schema()->Column(idx)->max_definition_level();
+
+  std::vector<int16_t> def_lvl(batchSize);
+  std::vector<parquet::ByteArray> values(batchSize);
+  int64_t i = 0;
+  for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+    std::shared_ptr<parquet::ColumnReader> column_reader = parquet_reader->RowGroup(r)->Column(idx);
+    parquet::ByteArrayReader* reader = static_cast<parquet::ByteArrayReader*>(column_reader.get());
+    while (reader->HasNext()) {
+      int64_t values_read = 0;
+      int64_t levels_read = reader->ReadBatch(batchSize, def_lvl.data(), nullptr, values.data(), &values_read);
+      int64_t v = 0;
+      for (int64_t j = 0; j < levels_read; j++) {
+        if(def_lvl[j] == max_def) {
+          auto& value = values[v++];
+          memcpy(&chpl_ptr[i], value.ptr, value.len);
+          i += value.len + 1;
+        }
+      }
+    }
+  }
+  return i;
+}
+
+int main(int argc, char** argv) {
+  if(argc < 4) {
+    std::cout << "Usage: " << argv[0] << " <filename> <column name> <batch size>\n";
+    return 1;
+  }
+  std::string filename = argv[1];
+  std::string colname = argv[2];
+  int64_t batchSize = atoi(argv[3]);
+
+  // every byte of the column chunks plus a terminator per value bounds
+  // the bytes read
+  std::shared_ptr<parquet::FileMetaData> file_metadata =
+    parquet::ParquetFileReader::OpenFile(filename, false)->metadata();
+  auto idx = file_metadata->schema()->group_node()->FieldIndex(colname);
+  int64_t capacity = 0;
+  for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+    auto chunk = file_metadata->RowGroup(r)->ColumnChunk(idx);
+    capacity += chunk->total_uncompressed_size() + chunk->num_values();
+  }
+  unsigned char* chpl_ptr = (unsigned char*)malloc(capacity);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  int64_t numBytes = readOneAtATime(filename, colname, chpl_ptr);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(finish-start);
+  std::cout << "Reading " << numBytes << " bytes one value at a time: " << milliseconds.count()/1000.0 << "s\n";
+
+  start = std::chrono::high_resolution_clock::now();
+  numBytes = readBatched(filename, colname, chpl_ptr, batchSize);
+  finish = std::chrono::high_resolution_clock::now();
+  milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(finish-start);
+  std::cout << "Reading " << numBytes << " bytes in batches of " << batchSize << ": " << milliseconds.count()/1000.0 << "s\n";
+
+  free(chpl_ptr);
+  return 0;
+}
@@ -0,0 +1,152 @@
+// Micro-benchmark for the string copy loops in ArrowFunctions.cpp.
+//
+// Compares the per-character loops the Parquet readers/writers used to
+// move string bytes with the memcpy/strlen based versions that replaced
+// them, in the shape of the string column reader and writer. One string
+// in 16 is null. It doesn't depend on Arrow, a ByteArray here has the same layout
+// as parquet::ByteArray (a length and a pointer into decoded page data).
+//
+// Compile: g++ string-copy-bench.cpp -O3 -std=c++17
+// Run:     ./a.out <number of strings> <average string length>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct ByteArray {
+  uint32_t len;
+  const uint8_t* ptr;
+};
+
+// Reading: copy a batch of values into null terminated strings, the way
+// cpp_readStrColumnByName does, recording each string's length with its
+// terminator. def_lvl marks the nulls (0), which are read as empty strings.
+int64_t readCharLoop(const std::vector<ByteArray>& values, const std::vector<int16_t>& def_lvl,
+                     uint8_t* chpl_ptr, int64_t* lengths) {
+  int64_t i = 0;
+  int64_t v = 0;
+  for (size_t j = 0; j < def_lvl.size(); j++) {
+    if(def_lvl[j] == 1) {
+      auto& value = values[v++];
+      for(uint32_t k = 0; k < value.len; k++) {
+        chpl_ptr[i] = value.ptr[k];
+        i++;
+      }
+      lengths[j] = value.len + 1;
+    } else {
+      lengths[j] = 1;
+    }
+    chpl_ptr[i++] = 0;
+  }
+  return i;
+}
+
+int64_t readMemcpy(const std::vector<ByteArray>& values, const std::vector<int16_t>& def_lvl,
+                   uint8_t* chpl_ptr, int64_t* lengths) {
+  int64_t i = 0;
+  int64_t v = 0;
+  for (size_t j = 0; j < def_lvl.size(); j++) {
+    if(def_lvl[j] == 1) {
+      auto& value = values[v++];
+      memcpy(&chpl_ptr[i], value.ptr, value.len);
+      i += value.len;
+      lengths[j] = value.len + 1;
+    } else {
+      lengths[j] = 1;
+    }
+    chpl_ptr[i++] = 0;
+  }
+  return i;
+}
+
+// Writing: find the end of each null terminated string
+int64_t writeCharLoop(const uint8_t* data_ptr, int64_t numStrings, std::vector<ByteArray>& out) {
+  int64_t byteIdx = 0;
+  for (int64_t s = 0; s < numStrings; s++) {
+    ByteArray value;
+    value.ptr = &data_ptr[byteIdx];
+    int64_t nextIdx = byteIdx;
+    while (data_ptr[nextIdx] != 0x00){
+      nextIdx++;
+    }
+    value.len = nextIdx - byteIdx;
+    out[s] = value;
+    byteIdx = nextIdx + 1;
+  }
+  return byteIdx;
+}
+
+int64_t writeStrlen(const uint8_t* data_ptr, int64_t numStrings, std::vector<ByteArray>& out) {
+  int64_t byteIdx = 0;
+  for (int64_t s = 0; s < numStrings; s++) {
+    ByteArray value;
+    value.ptr = &data_ptr[byteIdx];
+    value.len = strlen(reinterpret_cast<const char*>(value.ptr));
+    out[s] = value;
+    byteIdx += value.len + 1;
+  }
+  return byteIdx;
+}
+
+template <typename F>
+double bytesPerSec(int64_t numBytes, int reps, F&& f) {
+  f(); // warm up
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < reps; r++)
+    f();
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+  return numBytes * (double)reps / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+  if(argc < 3) {
+    std::cout << "Usage: " << argv[0] << " <number of strings> <average string length>\n";
+    return 1;
+  }
+  int64_t numStrings = atoll(argv[1]);
+  int64_t avgLen = atoll(argv[2]);
+  const int reps = 10;
+
+  // Decoded page data is a run of values, lengths vary around avgLen
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int64_t> lenDist(0, 2 * avgLen);
+  std::vector<uint32_t> lens(numStrings);
+  int64_t numBytes = 0;
+  for (auto& len : lens) {
+    len = lenDist(gen);
+    numBytes += len + 1;
+  }
+  std::vector<uint8_t> page(numBytes);
+  std::vector<ByteArray> values;
+  std::vector<int16_t> def_lvl(numStrings);
+  int64_t off = 0;
+  for (int64_t s = 0; s < numStrings; s++) {
+    for (uint32_t j = 0; j < lens[s]; j++)
+      page[off + j] = 'a' + (j % 26);
+    page[off + lens[s]] = 0;
+    def_lvl[s] = (s % 16 != 15);
+    if(def_lvl[s])
+      values.push_back({lens[s], &page[off]});
+    off += lens[s] + 1;
+  }
+  std::vector<uint8_t> dest(numBytes);
+  std::vector<int64_t> lengths(numStrings);
+  std::vector<ByteArray> found(numStrings);
+
+  double gb = 1e9;
+  std::cout << "strings: " << numStrings << ", average length: " << avgLen
+            << ", bytes: " << numBytes << "\n";
+  std::cout << "read  char loop: " << bytesPerSec(numBytes, reps, [&]() { return readCharLoop(values, def_lvl, dest.data(), lengths.data()); }) / gb << " GB/s\n";
+  std::cout << "read  memcpy:    " << bytesPerSec(numBytes, reps, [&]() { return readMemcpy(values, def_lvl, dest.data(), lengths.data()); }) / gb << " GB/s\n";
+  std::cout << "write char loop: " << bytesPerSec(numBytes, reps, [&]() { return writeCharLoop(page.data(), numStrings, found); }) / gb << " GB/s\n";
+  std::cout << "write strlen:    " << bytesPerSec(numBytes, reps, [&]() { return writeStrlen(page.data(), numStrings, found); }) / gb << " GB/s\n";
+
+  // keep the results live
+  return dest[numBytes / 2] == 0xFF && found[numStrings / 2].len == 0xFFFFFFFF;
+}
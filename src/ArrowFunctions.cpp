@@ -40,6 +40,521 @@ bool check_status_ok(arrow::Status status, char** errMsg) {
   return true;
 }
 
+/*
+  Parquet File Cache
+  ------------------
+  Reading a dataset calls several of the functions below on every
+  file (type, size, byte counts, values...), and each of them used to
+  reopen the file and re-parse its footer. The cache keeps the opened
+  reader along with the parsed FileMetaData and Arrow schema for each
+  file so that the footer is only parsed once per file.
+
+  Entries are keyed on the path and validated against the file's
+  modification time and size, so a file that is rewritten is reopened
+  on next access. Writers also explicitly invalidate the files they
+  write. The number of entries (and so the number of open files) is
+  capped and the least recently used entry is evicted first. Entries
+  are handed out as shared pointers, so an evicted entry stays valid
+  for any reader still using it.
+
+  Files can optionally be memory mapped instead of read with pread.
+  Mapping pays off for files on local disks that are read over and
+  over: pages are served straight from the page cache, and uncompressed
+  pages are decoded in place rather than copied into Arrow buffers
+  first. On network file systems mapping gives up the file system's own
+  read-ahead and can fault on a remote server that goes away, so those
+  files, and any file that fails to map, are read normally.
+*/
+static std::atomic<bool> parquetMemoryMap(false);
+
+// file systems that are mapped from remote servers
+static bool isNetworkFileSystem(const std::string& path) {
+#if defined(__linux__)
+  struct statfs fs;
+  if(statfs(path.c_str(), &fs) != 0)
+    return true;
+  switch((uint32_t)fs.f_type) {
+    case 0x6969:     // NFS
+    case 0x0BD00BD0: // Lustre
+    case 0x47504653: // GPFS
+    case 0xFF534D42: // CIFS
+    case 0xFE534D42: // SMB2
+    case 0x517B:     // SMB
+    case 0x00C36400: // Ceph
+    case 0x19830326: // BeeGFS
+    case 0x65735546: // FUSE
+      return true;
+    default:
+      return false;
+  }
+#else
+  // don't know how to tell, so don't map
+  return true;
+#endif
+}
+
+static arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> openParquetInput(const std::string& path) {
+  if(parquetMemoryMap.load() && !isNetworkFileSystem(path)) {
+    auto mapped = arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ);
+    if(mapped.ok())
+      return std::static_pointer_cast<arrow::io::RandomAccessFile>(*mapped);
+  }
+  std::shared_ptr<arrow::io::RandomAccessFile> file;
+  ARROW_ASSIGN_OR_RAISE(file, arrow::io::ReadableFile::Open(path, arrow::default_memory_pool()));
+  return file;
+}
+
+struct CachedParquetFile {
+  int64_t mtime;
+  int64_t size;
+  std::shared_ptr<arrow::io::RandomAccessFile> source;
+  std::shared_ptr<parquet::ParquetFileReader> reader;
+  std::shared_ptr<parquet::FileMetaData> metadata;
+  std::shared_ptr<arrow::Schema> schema;
+};
+
+/*
+  Pre-buffered reads
+  ------------------
+  By default, each column chunk is read when its reader is created. That
+  is one read per column chunk per row group, each waiting on the file
+  system, which is slow on Lustre and NFS mounts. With pre-buffering on,
+  the readers first ask for every column chunk they will need. The
+  chunks are then fetched in the background through Arrow's read range
+  cache, which coalesces them into a few large reads:
+  - Gaps of up to the hole size limit between chunks are read through
+    rather than split into separate reads.
+  - No single read grows past the range size limit.
+  Pre-buffering needs a ParquetFileReader of its own, so that concurrent
+  reads of a cached file don't replace each other's buffers. That reader
+  shares the cached source and parsed footer.
+
+  Separately, the buffered stream size reads column chunks through a
+  stream of that size rather than all at once, which bounds memory use
+  for very large chunks. 0 turns it off.
+*/
+static std::atomic<bool> parquetPreBuffer(false);
+static std::atomic<int64_t> parquetHoleSizeLimit(arrow::io::CacheOptions::Defaults().hole_size_limit);
+static std::atomic<int64_t> parquetRangeSizeLimit(arrow::io::CacheOptions::Defaults().range_size_limit);
+static std::atomic<int64_t> parquetBufferedStreamSize(0);
+
+static parquet::ReaderProperties parquetReaderProperties() {
+  parquet::ReaderProperties props = parquet::default_reader_properties();
+  int64_t size = parquetBufferedStreamSize.load();
+  if(size > 0) {
+    props.enable_buffered_stream();
+    props.set_buffer_size(size);
+  }
+  return props;
+}
+
+class ParquetFileCache {
+public:
+  arrow::Result<std::shared_ptr<CachedParquetFile>> Get(const std::string& path) {
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0)
+      return arrow::Status::IOError("Failed to open local file '" + path + "'");
+    int64_t mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+    int64_t size = (int64_t)st.st_size;
+
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      auto it = entries.find(path);
+      if(it != entries.end()) {
+        if(it->second.file->mtime == mtime && it->second.file->size == size) {
+          lru.splice(lru.begin(), lru, it->second.pos);
+          return it->second.file;
+        }
+        // the file changed on disk, drop the stale entry
+        lru.erase(it->second.pos);
+        entries.erase(it);
+      }
+    }
+
+    // open outside of the lock so that a slow open doesn't
+    // serialize opens of other files
+    auto file = std::make_shared<CachedParquetFile>();
+    file->mtime = mtime;
+    file->size = size;
+    ARROW_ASSIGN_OR_RAISE(file->source, openParquetInput(path));
+    file->reader = parquet::ParquetFileReader::Open(file->source, parquetReaderProperties());
+    file->metadata = file->reader->metadata();
+    ARROW_RETURN_NOT_OK(parquet::arrow::FromParquetSchema(file->metadata->schema(),
+                                                         parquet::default_arrow_reader_properties(),
+                                                         file->metadata->key_value_metadata(),
+                                                         &file->schema));
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entries.find(path);
+    if(it != entries.end()) {
+      // another thread opened the same file while we were opening it
+      if(it->second.file->mtime == mtime && it->second.file->size == size) {
+        lru.splice(lru.begin(), lru, it->second.pos);
+        return it->second.file;
+      }
+      lru.erase(it->second.pos);
+      entries.erase(it);
+    }
+    if(capacity <= 0)
+      return file;
+    lru.push_front(path);
+    entries[path] = {file, lru.begin()};
+    evict();
+    return file;
+  }
+
+  void Invalidate(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entries.find(path);
+    if(it != entries.end()) {
+      lru.erase(it->second.pos);
+      entries.erase(it);
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.clear();
+    lru.clear();
+  }
+
+  // A negative capacity picks the default, see defaultCapacity
+  void SetCapacity(int64_t cap) {
+    std::lock_guard<std::mutex> lock(mtx);
+    capacity = (cap < 0) ? defaultCapacity() : cap;
+    evict();
+  }
+
+private:
+  struct Entry {
+    std::shared_ptr<CachedParquetFile> file;
+    std::list<std::string>::iterator pos;
+  };
+
+  // Every cached file holds a descriptor open, so by default the cache
+  // only takes up an eighth of the soft open file limit. The rest is
+  // left for the server's sockets, logs and files read uncached.
+  static int64_t defaultCapacity() {
+    struct rlimit rl;
+    if(getrlimit(RLIMIT_NOFILE, &rl) != 0 || rl.rlim_cur == RLIM_INFINITY)
+      return 1024;
+    return std::min((int64_t)(rl.rlim_cur / 8), (int64_t)1024);
+  }
+
+  // must be called with mtx held
+  void evict() {
+    while((int64_t)lru.size() > std::max(capacity, (int64_t)0)) {
+      entries.erase(lru.back());
+      lru.pop_back();
+    }
+  }
+
+  std::mutex mtx;
+  int64_t capacity = defaultCapacity();
+  std::list<std::string> lru; // most recently used first
+  std::unordered_map<std::string, Entry> entries;
+};
+
+static ParquetFileCache parquetFileCache;
+
+arrow::Result<std::shared_ptr<CachedParquetFile>> openCachedParquetFile(const char* filename) {
+  return parquetFileCache.Get(std::string(filename));
+}
+
+/*
+  Widening int32 columns
+  ----------------------
+  int32 and uint32 columns are stored as int64 in Chapel. Rather than
+  decoding into a separate buffer and copying, a batch is decoded into
+  the back half of the int64 slots it is headed for and widened front to
+  back into place. Widening value j writes int32 slots 2j and 2j+1 of the
+  destination while the values not yet widened start at slot
+  batchSize+j+1, so nothing is overwritten before it is read. The SIMD
+  kernel loads each block before storing it, which keeps that true for
+  whole blocks.
+*/
+template <bool isSigned>
+void widenInt32(const int32_t* in, int64_t* out, int64_t n) {
+  int64_t j = 0;
+#if defined(__SSE2__)
+  for (; j + 4 <= n; j += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + j));
+    __m128i ext = isSigned ? _mm_srai_epi32(v, 31) : _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi32(v, ext);
+    __m128i hi = _mm_unpackhi_epi32(v, ext);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j + 2), hi);
+  }
+#endif
+  // in and out alias, so go through memcpy rather than typed accesses
+  for (; j < n; j++) {
+    int32_t x;
+    memcpy(&x, in + j, sizeof(x));
+    int64_t y = isSigned ? (int64_t)x : (int64_t)(uint32_t)x;
+    memcpy(out + j, &y, sizeof(y));
+  }
+}
+
+template <bool isSigned>
+int64_t readBatchWidened(parquet::Int32Reader* reader, int64_t batchSize,
+                         int16_t* def_lvl, int16_t* rep_lvl,
+                         int64_t* dst, int64_t* values_read) {
+  int32_t* tail = reinterpret_cast<int32_t*>(dst) + batchSize;
+  int64_t levels_read = reader->ReadBatch(batchSize, def_lvl, rep_lvl, tail, values_read);
+  widenInt32<isSigned>(tail, dst, *values_read);
+  return levels_read;
+}
+
+// Scratch space for decoding batches. It is kept per thread so that it is
+// reused across batches, row groups and calls rather than allocated for
+// each of them.
+struct ReadScratch {
+  std::vector<int16_t> def_lvl;
+  std::vector<int16_t> rep_lvl;
+  std::vector<uint8_t> vals;
+
+  int16_t* defLevels(int64_t n) {
+    if((int64_t)def_lvl.size() < n)
+      def_lvl.resize(n);
+    return def_lvl.data();
+  }
+
+  int16_t* repLevels(int64_t n) {
+    if((int64_t)rep_lvl.size() < n)
+      rep_lvl.resize(n);
+    return rep_lvl.data();
+  }
+
+  template <typename T>
+  T* values(int64_t n) {
+    if((int64_t)vals.size() < n * (int64_t)sizeof(T))
+      vals.resize(n * sizeof(T));
+    return reinterpret_cast<T*>(vals.data());
+  }
+};
+
+static thread_local ReadScratch readScratch;
+
+/*
+ Column decoding
+ ---------------
+ Every fixed width column, flat or the values of a list, is decoded by
+ readValues. A column type is described by the Parquet reader for its
+ physical type, the type a value is interpreted as (uint32 is stored as
+ int32, for example) and the element type of the Chapel array, and
+ withColumnType maps a type code to that description. Adding a type
+ that fits this shape only needs a new entry there.
+
+ Each batch is decoded so that its non-null values are packed at the
+ front of the slots they are headed for, converting them if the types
+ differ, and then spread out to make room for nulls if there are any.
+ A level has a slot if it is defined at slotDef or deeper, which is
+ every level for a flat column. Nulls are NaN in floating point arrays
+ and zero otherwise. For a flat column, readValues can also set the
+ bits of a validity bitmap from the definition levels as it goes.
+*/
+template <typename ReaderT, typename ValT, typename DstT>
+struct ColumnType {
+  using Reader = ReaderT;
+  using Val = ValT;
+  using Dst = DstT;
+};
+
+template <typename F>
+bool withColumnType(int64_t ty, F&& fn) {
+  switch (ty) {
+    // int64 and uint64 share a physical type and only differ in logical
+    // type, so they are read the same way
+    case ARROWINT64:
+    case ARROWUINT64: fn(ColumnType<parquet::Int64Reader, int64_t, int64_t>()); return true;
+    case ARROWINT32: fn(ColumnType<parquet::Int32Reader, int32_t, int64_t>()); return true;
+    case ARROWUINT32: fn(ColumnType<parquet::Int32Reader, uint32_t, int64_t>()); return true;
+    case ARROWBOOLEAN: fn(ColumnType<parquet::BoolReader, bool, bool>()); return true;
+    case ARROWFLOAT: fn(ColumnType<parquet::FloatReader, float, double>()); return true;
+    case ARROWDOUBLE: fn(ColumnType<parquet::DoubleReader, double, double>()); return true;
+    default: return false;
+  }
+}
+
+template <typename T>
+T nullValue() {
+  if constexpr (std::is_floating_point<T>::value)
+    return NAN;
+  else
+    return T{};
+}
+
+// The shallowest definition level that has a slot in the values of a
+// list. A null element of a float list is read as NaN, so it has one,
+// while the other types drop null elements.
+template <typename DstT>
+int16_t listValueDef(int16_t max_def) {
+  return std::is_floating_point<DstT>::value ? std::min<int16_t>(2, max_def) : max_def;
+}
+
+// ReadBatch packs the non-null values of a batch at the front of the
+// output. Spread them out to their slots in place, filling in nulls.
+// This walks backwards since values only move later. Returns the number
+// of slots filled.
+template <typename T>
+int64_t spreadNulls(T* vals, const int16_t* def_lvl, int16_t max_def, int16_t slotDef,
+                    int64_t levels_read, int64_t values_read) {
+  int64_t numSlots = levels_read;
+  if(slotDef > 0) {
+    numSlots = 0;
+    for (int64_t j = 0; j < levels_read; j++)
+      numSlots += def_lvl[j] >= slotDef;
+  }
+  int64_t s = numSlots - 1;
+  int64_t v = values_read - 1;
+  for (int64_t j = levels_read - 1; j >= 0; j--) {
+    if(def_lvl[j] < slotDef)
+      continue;
+    vals[s--] = (def_lvl[j] < max_def) ? nullValue<T>() : vals[v--];
+  }
+  return numSlots;
+}
+
+// Set the validity bits of n rows, starting at row bit of the bitmap,
+// from their definition levels. The bitmap has 1 bit per row, least
+// significant bit first like Arrow's, and starts zeroed. Row groups read
+// on different threads can share the byte at either end of their rows,
+// so partially covered bytes are updated atomically.
+void setValidityBits(uint8_t* validity, int64_t bit, const int16_t* def_lvl,
+                     int16_t max_def, int64_t n) {
+  int64_t j = 0;
+  while (j < n) {
+    int64_t byteIdx = (bit + j) >> 3;
+    int shift = (bit + j) & 7;
+    int64_t m = std::min<int64_t>(8 - shift, n - j);
+    uint8_t bits = 0;
+    for (int64_t k = 0; k < m; k++)
+      bits |= (uint8_t)(def_lvl == nullptr || def_lvl[j+k] == max_def) << (shift + k);
+    if(m == 8)
+      validity[byteIdx] = bits;
+    else
+      __atomic_fetch_or(&validity[byteIdx], bits, __ATOMIC_RELAXED);
+    j += m;
+  }
+}
+
+// Read up to numElems slots from the current position of reader into
+// dst. Returns the number of slots filled. If validity isn't null the
+// bit of each row read is set in it, starting at bit validityIdx.
+// Integer values are multiplied by multiplier while the batch is hot,
+// which is how time columns are converted to nanoseconds.
+template <typename ReaderT, typename ValT, typename DstT>
+int64_t readValues(ReaderT* reader, int16_t max_def, int16_t slotDef, bool repeated,
+                   DstT* dst, uint8_t* validity, int64_t validityIdx,
+                   int64_t numElems, int64_t batchSize, int64_t multiplier = 1) {
+  using PhysT = typename ReaderT::T;
+  // definition levels are only needed to place nulls
+  int16_t* def_lvl = (max_def != 0) ? readScratch.defLevels(batchSize) : nullptr;
+  int16_t* rep_lvl = repeated ? readScratch.repLevels(batchSize) : nullptr;
+
+  int64_t i = 0;
+  while (reader->HasNext() && i < numElems) {
+    if((numElems - i) < batchSize) // adjust batchSize if needed
+      batchSize = numElems - i;
+
+    int64_t values_read = 0;
+    int64_t levels_read;
+    if constexpr (std::is_same<PhysT, DstT>::value) {
+      // values are read straight into dst
+      levels_read = reader->ReadBatch(batchSize, def_lvl, rep_lvl, &dst[i], &values_read);
+    } else if constexpr (std::is_same<PhysT, int32_t>::value &&
+                         std::is_same<DstT, int64_t>::value) {
+      levels_read = readBatchWidened<std::is_signed<ValT>::value>(reader, batchSize, def_lvl, rep_lvl,
+                                                                   &dst[i], &values_read);
+    } else if constexpr (std::is_same<PhysT, parquet::Int96>::value) {
+      // legacy timestamps, nanoseconds of the day and a Julian day
+      parquet::Int96* tmpArr = readScratch.values<parquet::Int96>(batchSize);
+      levels_read = reader->ReadBatch(batchSize, def_lvl, rep_lvl, tmpArr, &values_read);
+      for (int64_t j = 0; j < values_read; j++)
+        dst[i+j] = parquet::Int96GetNanoSeconds(tmpArr[j]);
+    } else {
+      PhysT* tmpArr = readScratch.values<PhysT>(batchSize);
+      levels_read = reader->ReadBatch(batchSize, def_lvl, rep_lvl, tmpArr, &values_read);
+      for (int64_t j = 0; j < values_read; j++)
+        dst[i+j] = (DstT)(ValT)tmpArr[j];
+    }
+    if constexpr (std::is_integral<DstT>::value && !std::is_same<DstT, bool>::value) {
+      if(multiplier != 1)
+        for (int64_t j = 0; j < values_read; j++)
+          dst[i+j] *= multiplier;
+    }
+
+    if(validity)
+      setValidityBits(validity, validityIdx + i, def_lvl, max_def, levels_read);
+    if(levels_read == values_read)
+      i += values_read;
+    else
+      i += spreadNulls(&dst[i], def_lvl, max_def, slotDef, levels_read, values_read);
+  }
+  return i;
+}
+
+// The number of 64-bit limbs a decimal is read as, see DECIMAL_INT64_PRECISION
+int decimalNumLimbs(int32_t precision) {
+  if(precision <= DECIMAL_INT64_PRECISION)
+    return 1;
+  return (precision <= 38) ? 2 : 4;
+}
+
+// Decode the big-endian two's complement bytes of a decimal's unscaled
+// value into numLimbs little-endian 64-bit limbs, sign extending it.
+// Bytes beyond the limbs can only hold sign extension, since the
+// precision bounds the value, so they are dropped.
+inline void decodeDecimal(const uint8_t* bytes, int64_t len, uint64_t* limbs, int numLimbs) {
+  uint64_t fill = (len > 0 && (bytes[0] & 0x80)) ? ~(uint64_t)0 : 0;
+  for (int l = 0; l < numLimbs; l++)
+    limbs[l] = fill;
+  for (int64_t b = 0; b < len && b < 8 * numLimbs; b++) {
+    int shift = (b % 8) * 8;
+    uint64_t& limb = limbs[b / 8];
+    limb = (limb & ~((uint64_t)0xFF << shift)) | ((uint64_t)bytes[len - 1 - b] << shift);
+  }
+}
+
+// Read up to numElems decimals stored as fixed or variable length byte
+// arrays into dst, numLimbs limbs per value. Nulls are zero. The
+// validity bitmap works as it does for readValues.
+template <typename ReaderT>
+int64_t readDecimals(ReaderT* reader, int16_t max_def, int32_t byteLength, int numLimbs,
+                     uint64_t* dst, uint8_t* validity, int64_t validityIdx,
+                     int64_t numElems, int64_t batchSize) {
+  using PhysT = typename ReaderT::T;
+  int16_t* def_lvl = (max_def != 0) ? readScratch.defLevels(batchSize) : nullptr;
+  PhysT* vals = readScratch.values<PhysT>(batchSize);
+
+  int64_t i = 0;
+  while (reader->HasNext() && i < numElems) {
+    if((numElems - i) < batchSize)
+      batchSize = numElems - i;
+
+    int64_t values_read = 0;
+    int64_t levels_read = reader->ReadBatch(batchSize, def_lvl, nullptr, vals, &values_read);
+    if(validity)
+      setValidityBits(validity, validityIdx + i, def_lvl, max_def, levels_read);
+
+    int64_t v = 0;
+    for (int64_t j = 0; j < levels_read; j++) {
+      uint64_t* limbs = dst + (i + j) * numLimbs;
+      if(def_lvl && def_lvl[j] < max_def) {
+        std::fill(limbs, limbs + numLimbs, 0);
+        continue;
+      }
+      const PhysT& value = vals[v++];
+      if constexpr (std::is_same<PhysT, parquet::ByteArray>::value)
+        decodeDecimal(value.ptr, value.len, limbs, numLimbs);
+      else
+        decodeDecimal(value.ptr, byteLength, limbs, numLimbs);
+    }
+    i += levels_read;
+  }
+  return i;
+}
+
 /*
  C++ functions
  -------------
@@ -51,14 +566,10 @@ bool check_status_ok(arrow::Status status, char** errMsg) {
 
 int64_t cpp_getNumRows(const char* filename, char** errMsg) {
   try {
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROWRESULT_OK(arrow::io::ReadableFile::Open(filename, arrow::default_memory_pool()),
-                   infile);
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
 
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROWSTATUS_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-  
-    return reader -> parquet_reader() -> metadata() -> num_rows();
+    return pqFile -> metadata -> num_rows();
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
     return ARROWERROR;
@@ -67,16 +578,9 @@ int64_t cpp_getNumRows(const char* filename, char** errMsg) {
 
 int cpp_getPrecision(const char* filename, const char* colname, char** errMsg) {
   try {
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROWRESULT_OK(arrow::io::ReadableFile::Open(filename, arrow::default_memory_pool()),
-                   infile);
-
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROWSTATUS_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-
-    std::shared_ptr<arrow::Schema> sc;
-    std::shared_ptr<arrow::Schema>* out = &sc;
-    ARROWSTATUS_OK(reader->GetSchema(out));
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<arrow::Schema> sc = pqFile->schema;
 
     int idx = sc -> GetFieldIndex(colname);
 
@@ -90,18 +594,134 @@ int cpp_getPrecision(const char* filename, const char* colname, char** errMsg) {
   }
 }
 
-int cpp_getType(const char* filename, const char* colname, char** errMsg) {
+int cpp_getScale(const char* filename, const char* colname, char** errMsg) {
   try {
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROWRESULT_OK(arrow::io::ReadableFile::Open(filename, arrow::default_memory_pool()),
-                   infile);
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<arrow::Schema> sc = pqFile->schema;
+
+    int idx = sc -> GetFieldIndex(colname);
+
+    const auto& decimal_type = static_cast<const ::arrow::DecimalType&>(*sc->field(idx)->type());
+    return decimal_type.scale();
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
+
+int timeUnitCode(arrow::TimeUnit::type unit) {
+  switch (unit) {
+    case arrow::TimeUnit::SECOND: return TIMEUNIT_SECOND;
+    case arrow::TimeUnit::MILLI: return TIMEUNIT_MILLI;
+    case arrow::TimeUnit::MICRO: return TIMEUNIT_MICRO;
+    default: return TIMEUNIT_NANO;
+  }
+}
+
+// The TIMEUNIT_* the values of a time column are stored in, -1 if it
+// isn't one. This is the unit in the file, which isn't always the unit
+// of the Arrow type: Parquet has no seconds or date64, so those are
+// stored as milliseconds and days, and INT96 timestamps are converted
+// to nanoseconds as they are decoded. Durations have no Parquet logical
+// type and are stored in the unit of the Arrow type.
+int storedTimeUnit(const parquet::ColumnDescriptor* descr,
+                   const std::shared_ptr<arrow::DataType>& type) {
+  switch (type->id()) {
+    case arrow::Type::DATE32:
+    case arrow::Type::DATE64:
+      return TIMEUNIT_DAY;
+    case arrow::Type::TIMESTAMP: {
+      if(descr->physical_type() == parquet::Type::INT96)
+        return TIMEUNIT_NANO;
+      auto logical = descr->logical_type();
+      if(logical && logical->is_timestamp()) {
+        switch (static_cast<const parquet::TimestampLogicalType&>(*logical).time_unit()) {
+          case parquet::LogicalType::TimeUnit::MILLIS: return TIMEUNIT_MILLI;
+          case parquet::LogicalType::TimeUnit::MICROS: return TIMEUNIT_MICRO;
+          case parquet::LogicalType::TimeUnit::NANOS: return TIMEUNIT_NANO;
+          default: break;
+        }
+      }
+      return timeUnitCode(static_cast<const arrow::TimestampType&>(*type).unit());
+    }
+    case arrow::Type::DURATION:
+      return timeUnitCode(static_cast<const arrow::DurationType&>(*type).unit());
+    default:
+      return -1;
+  }
+}
+
+// What a stored value of a time column is multiplied by to get
+// nanoseconds, 1 for everything else
+int64_t nanosPerUnit(int timeUnit) {
+  switch (timeUnit) {
+    case TIMEUNIT_SECOND: return 1000000000LL;
+    case TIMEUNIT_MILLI: return 1000000LL;
+    case TIMEUNIT_MICRO: return 1000LL;
+    case TIMEUNIT_DAY: return 86400LL * 1000000000LL;
+    default: return 1;
+  }
+}
+
+// The Arkouda type code for an Arrow type, ARROWERROR if it can't be read
+int getTypeCode(const std::shared_ptr<arrow::DataType>& myType) {
+  if(myType->id() == arrow::Type::INT64)
+    return ARROWINT64;
+  else if(myType->id() == arrow::Type::INT32 || myType->id() == arrow::Type::INT16 ||
+          myType->id() == arrow::Type::INT8)
+    return ARROWINT32; // int8 and int16 are logical types, stored as int32
+  else if(myType->id() == arrow::Type::UINT64)
+    return ARROWUINT64;
+  else if(myType->id() == arrow::Type::UINT32 || 
+          myType->id() == arrow::Type::UINT16 ||
+          myType->id() == arrow::Type::UINT8)
+    return ARROWUINT32; // uint8 and uint16 are logical types, stored as uint32
+  else if(myType->id() == arrow::Type::TIMESTAMP)
+    return ARROWTIMESTAMP;
+  else if(myType->id() == arrow::Type::DATE32 ||
+          myType->id() == arrow::Type::DATE64)
+    return ARROWDATE;
+  else if(myType->id() == arrow::Type::DURATION)
+    return ARROWDURATION;
+  else if(myType->id() == arrow::Type::BOOL)
+    return ARROWBOOLEAN;
+  else if(myType->id() == arrow::Type::STRING ||
+          myType->id() == arrow::Type::BINARY)
+    return ARROWSTRING;
+  else if(myType->id() == arrow::Type::FLOAT)
+    return ARROWFLOAT;
+  else if(myType->id() == arrow::Type::DOUBLE)
+    return ARROWDOUBLE;
+  else if(myType->id() == arrow::Type::LIST)
+    return ARROWLIST;
+  else if(myType->id() == arrow::Type::DECIMAL)
+    return ARROWDECIMAL;
+  return ARROWERROR;
+}
 
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROWSTATUS_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
+// The Arkouda type code for the elements of a list, ARROWERROR if the
+// type isn't a list or its elements can't be read
+int getListTypeCode(const std::shared_ptr<arrow::DataType>& myType) {
+  if(myType->id() != arrow::Type::LIST || myType->num_fields() != 1)
+    return ARROWERROR;
+  // fields returns a vector of fields, but here we are expecting lists so should only contain 1 item here
+  int ty = getTypeCode(myType->fields()[0]->type());
+  if(ty == ARROWLIST || ty == ARROWDECIMAL)
+    return ARROWERROR;
+  // the values of a list are read as stored, without unit conversion
+  if(ty == ARROWTIMESTAMP || ty == ARROWDURATION)
+    return ARROWINT64;
+  if(ty == ARROWDATE)
+    return ARROWINT32;
+  return ty;
+}
 
-    std::shared_ptr<arrow::Schema> sc;
-    std::shared_ptr<arrow::Schema>* out = &sc;
-    ARROWSTATUS_OK(reader->GetSchema(out));
+int cpp_getType(const char* filename, const char* colname, char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<arrow::Schema> sc = pqFile->schema;
 
     int idx = sc -> GetFieldIndex(colname);
     // Since this doesn't actually throw a Parquet error, we have to generate
@@ -113,32 +733,9 @@ int cpp_getType(const char* filename, const char* colname, char** errMsg) {
       *errMsg = strdup(msg.c_str());
       return ARROWERROR;
     }
-    auto myType = sc -> field(idx) -> type();
-
-    if(myType->id() == arrow::Type::INT64)
-      return ARROWINT64;
-    else if(myType->id() == arrow::Type::INT32 || myType->id() == arrow::Type::INT16)
-      return ARROWINT32; // int16 is logical type, stored as int32
-    else if(myType->id() == arrow::Type::UINT64)
-      return ARROWUINT64;
-    else if(myType->id() == arrow::Type::UINT32 || 
-            myType->id() == arrow::Type::UINT16)
-      return ARROWUINT32; // uint16 is logical type, stored as uint32
-    else if(myType->id() == arrow::Type::TIMESTAMP)
-      return ARROWTIMESTAMP;
-    else if(myType->id() == arrow::Type::BOOL)
-      return ARROWBOOLEAN;
-    else if(myType->id() == arrow::Type::STRING ||
-            myType->id() == arrow::Type::BINARY)
-      return ARROWSTRING;
-    else if(myType->id() == arrow::Type::FLOAT)
-      return ARROWFLOAT;
-    else if(myType->id() == arrow::Type::DOUBLE)
-      return ARROWDOUBLE;
-    else if(myType->id() == arrow::Type::LIST)
-      return ARROWLIST;
-    else if(myType->id() == arrow::Type::DECIMAL)
-      return ARROWDECIMAL;
+    int ty = getTypeCode(sc -> field(idx) -> type());
+    if(ty != ARROWERROR)
+      return ty;
     else {
       std::string fname(filename);
       std::string dname(colname);
@@ -154,16 +751,9 @@ int cpp_getType(const char* filename, const char* colname, char** errMsg) {
 
 int cpp_getListType(const char* filename, const char* colname, char** errMsg) {
   try {
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROWRESULT_OK(arrow::io::ReadableFile::Open(filename, arrow::default_memory_pool()),
-                   infile);
-
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROWSTATUS_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-
-    std::shared_ptr<arrow::Schema> sc;
-    std::shared_ptr<arrow::Schema>* out = &sc;
-    ARROWSTATUS_OK(reader->GetSchema(out));
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<arrow::Schema> sc = pqFile->schema;
 
     int idx = sc -> GetFieldIndex(colname);
     // Since this doesn't actually throw a Parquet error, we have to generate
@@ -186,28 +776,9 @@ int cpp_getListType(const char* filename, const char* colname, char** errMsg) {
         return ARROWERROR;
       }
       else {
-        // fields returns a vector of fields, but here we are expecting lists so should only contain 1 item here
-        auto field = myType->fields()[0];
-        auto f_type = field->type();
-        if(f_type->id() == arrow::Type::INT64)
-          return ARROWINT64;
-        else if(f_type->id() == arrow::Type::INT32 || f_type->id() == arrow::Type::INT16)
-          return ARROWINT32;
-        else if(f_type->id() == arrow::Type::UINT64)
-          return ARROWUINT64;
-        else if(f_type->id() == arrow::Type::UINT32 || f_type->id() == arrow::Type::UINT16)
-          return ARROWUINT32;
-        else if(f_type->id() == arrow::Type::TIMESTAMP)
-          return ARROWTIMESTAMP;
-        else if(f_type->id() == arrow::Type::BOOL)
-          return ARROWBOOLEAN;
-        else if(f_type->id() == arrow::Type::STRING ||
-                f_type->id() == arrow::Type::BINARY)  // Verify that this is functional as expected
-          return ARROWSTRING;
-        else if(f_type->id() == arrow::Type::FLOAT)
-          return ARROWFLOAT;
-        else if(f_type->id() == arrow::Type::DOUBLE)
-          return ARROWDOUBLE;
+        int ty = getListTypeCode(myType);
+        if(ty != ARROWERROR)
+          return ty;
         else {
           std::string fname(filename);
           std::string dname(colname);
@@ -230,6 +801,93 @@ int cpp_getListType(const char* filename, const char* colname, char** errMsg) {
   }
 }
 
+int64_t cpp_getFileInfo(const char* filename, void* column_names, int64_t numCols,
+                        void* colInfo, void** rowGroupRows, int64_t* numRowGroups,
+                        char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<arrow::Schema> sc = pqFile->schema;
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
+    auto schema = file_metadata->schema();
+    int num_row_groups = file_metadata->num_row_groups();
+
+    auto names = (char**)column_names;
+    auto infos = (ColumnInfo*)colInfo;
+    for (int64_t c = 0; c < numCols; c++) {
+      int idx = sc -> GetFieldIndex(names[c]);
+      if(idx == -1) {
+        std::string fname(filename);
+        std::string dname(names[c]);
+        std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+      auto myType = sc -> field(idx) -> type();
+      ColumnInfo& info = infos[c];
+      info.typeCode = getTypeCode(myType);
+      if(info.typeCode == ARROWERROR) {
+        std::string fname(filename);
+        std::string dname(names[c]);
+        std::string msg = "Unsupported type on column: " + dname + " in " + fname; 
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+      info.listTypeCode = getListTypeCode(myType);
+      info.precision = 0;
+      info.scale = 0;
+      info.timeUnit = -1;
+      info.hasTimeZone = 0;
+      info.byteLength = -1;
+      info.nullCount = 0;
+      info.uncompressedSize = 0;
+
+      // sum over the leaf columns of the field, a list has its values in
+      // one leaf below the field
+      for (int leaf = 0; leaf < schema->num_columns(); leaf++) {
+        auto descr = schema->Column(leaf);
+        if(descr->path()->ToDotVector()[0] != names[c])
+          continue;
+        if(info.typeCode == ARROWDECIMAL) {
+          info.precision = descr->type_precision();
+          info.scale = descr->type_scale();
+          // bytes per value when stored as fixed length byte arrays
+          info.byteLength = descr->type_length();
+        }
+        if(info.typeCode == ARROWTIMESTAMP || info.typeCode == ARROWDATE ||
+           info.typeCode == ARROWDURATION) {
+          info.timeUnit = storedTimeUnit(descr, myType);
+          if(myType->id() == arrow::Type::TIMESTAMP)
+            info.hasTimeZone = !static_cast<const arrow::TimestampType&>(*myType).timezone().empty();
+        }
+        for (int r = 0; r < num_row_groups; r++) {
+          auto col_metadata = file_metadata->RowGroup(r)->ColumnChunk(leaf);
+          info.uncompressedSize += col_metadata->total_uncompressed_size();
+          auto stats = col_metadata->statistics();
+          if(info.nullCount >= 0 && stats && stats->HasNullCount())
+            info.nullCount += stats->null_count();
+          else
+            info.nullCount = -1; // unknown
+        }
+      }
+    }
+
+    *numRowGroups = num_row_groups;
+    if(rowGroupRows != nullptr) {
+      auto rows = (int64_t*)malloc(std::max(num_row_groups * sizeof(int64_t), sizeof(int64_t)));
+      if(!rows)
+        throw std::bad_alloc();
+      for (int r = 0; r < num_row_groups; r++)
+        rows[r] = file_metadata->RowGroup(r)->num_rows();
+      *rowGroupRows = rows;
+    }
+    return file_metadata->num_rows();
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
+
 int64_t cpp_getStringColumnNumBytes(const char* filename, const char* colname, void* chpl_offsets, int64_t numElems, int64_t startIdx, int64_t batchSize, char** errMsg) {
   try {
     int64_t ty = cpp_getType(filename, colname, errMsg);
@@ -244,10 +902,11 @@ int64_t cpp_getStringColumnNumBytes(const char* filename, const char* colname, v
     int64_t byteSize = 0;
 
     if(dty == ARROWSTRING) {
-      std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-        parquet::ParquetFileReader::OpenFile(filename, false);
+      std::shared_ptr<CachedParquetFile> pqFile;
+      ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+      std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
 
-      std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+      std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
       int num_row_groups = file_metadata->num_row_groups();
 
       int64_t i = 0;
@@ -327,18 +986,59 @@ int64_t cpp_getStringColumnNumBytes(const char* filename, const char* colname, v
   }
 }
 
+// Sizes of the rows of a list column being scanned, one row group at a
+// time. A row starts at each level with repetition level 0, and every
+// level defined at valueDef or deeper is a value of the current row.
+struct ListSizeScan {
+  int64_t* seg_sizes;
+  int64_t numRows;
+  int64_t row = -1;   // index of the current row
+  int64_t numValues = 0;
+};
+
+// Only the levels are needed, but the low-level API can't read them
+// without the values, so each batch is decoded into scratch space and
+// the values dropped. Reading in large batches rather than one level at
+// a time is what keeps this cheap.
+template <typename ReaderT>
+void scanListSizes(ReaderT* reader, int64_t batchSize, int16_t valueDef, ListSizeScan& scan) {
+  int16_t* def_lvl = readScratch.defLevels(batchSize);
+  int16_t* rep_lvl = readScratch.repLevels(batchSize);
+  auto values = readScratch.values<typename ReaderT::T>(batchSize);
+  while (reader->HasNext()) {
+    int64_t values_read = 0;
+    int64_t levels_read = reader->ReadBatch(batchSize, def_lvl, rep_lvl,
+                                            values, &values_read);
+    int64_t row = scan.row;
+    int64_t size = (row >= 0 && row < scan.numRows) ? scan.seg_sizes[row] : 0;
+    for (int64_t k = 0; k < levels_read; k++) {
+      if (rep_lvl[k] == 0) {
+        if (row >= 0 && row < scan.numRows)
+          scan.seg_sizes[row] = size;
+        row++;
+        size = 0;
+      }
+      int64_t isValue = def_lvl[k] >= valueDef;
+      size += isValue;
+      scan.numValues += isValue;
+    }
+    if (row >= 0 && row < scan.numRows)
+      scan.seg_sizes[row] = size;
+    scan.row = row;
+  }
+}
+
 int64_t cpp_getListColumnSize(const char* filename, const char* colname, void* chpl_seg_sizes, int64_t numElems, int64_t startIdx, char** errMsg) {
   try {
     int64_t ty = cpp_getType(filename, colname, errMsg);
-    auto seg_sizes = (int64_t*)chpl_seg_sizes;
-    int64_t listSize = 0;
     
     if (ty == ARROWLIST){
       int64_t lty = cpp_getListType(filename, colname, errMsg);
-      std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-          parquet::ParquetFileReader::OpenFile(filename, false);
+      std::shared_ptr<CachedParquetFile> pqFile;
+      ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+      std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
 
-      std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+      std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
       int num_row_groups = file_metadata->num_row_groups();
 
       auto idx = file_metadata -> schema() -> group_node() -> FieldIndex(colname);
@@ -349,166 +1049,25 @@ int64_t cpp_getListColumnSize(const char* filename, const char* colname, void* c
         *errMsg = strdup(msg.c_str());
         return ARROWERROR;
       }
+      int16_t max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level();
 
-      int64_t i = 0;
-      int64_t vct = 0;
-      int64_t seg_size = 0;
-      int64_t off = 0;
-      bool first = true;
+      ListSizeScan scan{(int64_t*)chpl_seg_sizes, numElems};
+      const int64_t batchSize = 8192;
       for (int r = 0; r < num_row_groups; r++) {
-        std::shared_ptr<parquet::RowGroupReader> row_group_reader =
-          parquet_reader->RowGroup(r);
-
-        int64_t values_read = 0;
-
-        std::shared_ptr<parquet::ColumnReader> column_reader;
-
-        column_reader = row_group_reader->Column(idx);
-        int16_t definition_level;
-        int16_t rep_lvl;
-
-        if(lty == ARROWINT64 || lty == ARROWUINT64) {
-          parquet::Int64Reader* int_reader =
-            static_cast<parquet::Int64Reader*>(column_reader.get());
-
-          while (int_reader->HasNext()) {
-            int64_t value;
-            (void)int_reader->ReadBatch(1, &definition_level, &rep_lvl, &value, &values_read);
-            if (values_read == 0 || (!first && rep_lvl == 0)) {
-              seg_sizes[i] = seg_size;
-              i++;
-              seg_size = 0;
-            }
-            if (values_read != 0) {
-              seg_size++;
-              vct++;
-              if (first) {
-                first = false;
-              }
-            }
-            if (values_read != 0 && !int_reader->HasNext()){
-              seg_sizes[i] = seg_size;
-            }
-          }
-        } else if(lty == ARROWINT32 || lty == ARROWUINT32) {
-          parquet::Int32Reader* int_reader =
-            static_cast<parquet::Int32Reader*>(column_reader.get());
-
-          while (int_reader->HasNext()) {
-            int32_t value;
-            (void)int_reader->ReadBatch(1, &definition_level, &rep_lvl, &value, &values_read);
-            if (values_read == 0 || (!first && rep_lvl == 0)) {
-              seg_sizes[i] = seg_size;
-              i++;
-              seg_size = 0;
-            }
-            if (values_read != 0) {
-              seg_size++;
-              vct++;
-              if (first) {
-                first = false;
-              }
-            }
-            if (values_read != 0 && !int_reader->HasNext()){
-              seg_sizes[i] = seg_size;
-            }
-          }
-        } else if (lty == ARROWSTRING) {
-          parquet::ByteArrayReader* reader =
-            static_cast<parquet::ByteArrayReader*>(column_reader.get());
+        std::shared_ptr<parquet::ColumnReader> column_reader =
+          parquet_reader->RowGroup(r)->Column(idx);
 
-          while (reader->HasNext()) {
-            parquet::ByteArray value;
-            (void)reader->ReadBatch(1, &definition_level, &rep_lvl, &value, &values_read);
-            if (values_read == 0 || (!first && rep_lvl == 0)) {
-              seg_sizes[i] = seg_size;
-              i++;
-              seg_size = 0;
-            }
-            if (values_read != 0) {
-              seg_size++;
-              vct++;
-              if (first) {
-                first = false;
-              }
-            }
-            if (values_read != 0 && !reader->HasNext()){
-              seg_sizes[i] = seg_size;
-            }
-          }
-        } else if(lty == ARROWBOOLEAN) {
-          parquet::BoolReader* bool_reader =
-            static_cast<parquet::BoolReader*>(column_reader.get());
-
-          while (bool_reader->HasNext()) {
-            bool value;
-            (void)bool_reader->ReadBatch(1, &definition_level, &rep_lvl, &value, &values_read);
-            if (values_read == 0 || (!first && rep_lvl == 0)) {
-              seg_sizes[i] = seg_size;
-              i++;
-              seg_size = 0;
-            }
-            if (values_read != 0) {
-              seg_size++;
-              vct++;
-              if (first) {
-                first = false;
-              }
-            }
-            if (values_read != 0 && !bool_reader->HasNext()){
-              seg_sizes[i] = seg_size;
-            }
-          }
-        } else if (lty == ARROWFLOAT) {
-          parquet::FloatReader* float_reader =
-            static_cast<parquet::FloatReader*>(column_reader.get());
-
-          int64_t numRead = 0;
-          while (float_reader->HasNext()) {
-            float value;
-            (void)float_reader->ReadBatch(1, &definition_level, &rep_lvl, &value, &values_read);
-            if ((values_read == 0 && definition_level != 2) || (!first && rep_lvl == 0)) {
-              seg_sizes[i] = seg_size;
-              i++;
-              seg_size = 0;
-            }
-            if (values_read != 0 || (values_read == 0 && definition_level == 2)) {
-              seg_size++;
-              vct++;
-              if (first) {
-                first = false;
-              }
-            }
-            if ((values_read != 0 || (values_read == 0 && definition_level == 2)) && !float_reader->HasNext()){
-              seg_sizes[i] = seg_size;
-            }
-          }
-        } else if(lty == ARROWDOUBLE) {
-          parquet::DoubleReader* dbl_reader =
-            static_cast<parquet::DoubleReader*>(column_reader.get());
-
-          while (dbl_reader->HasNext()) {
-            double value;
-            (void)dbl_reader->ReadBatch(1, &definition_level, &rep_lvl, &value, &values_read);
-            if ((values_read == 0 && definition_level != 2) || (!first && rep_lvl == 0)) {
-              seg_sizes[i] = seg_size;
-              i++;
-              seg_size = 0;
-            }
-            if (values_read != 0 || (values_read == 0 && definition_level == 2)) {
-              seg_size++;
-              vct++;
-              if (first) {
-                first = false;
-              }
-            }
-            if ((values_read != 0 || (values_read == 0 && definition_level == 2)) && !dbl_reader->HasNext()){
-              seg_sizes[i] = seg_size;
-            }
-          }
+        if (lty == ARROWSTRING) {
+          scanListSizes(static_cast<parquet::ByteArrayReader*>(column_reader.get()), batchSize, max_def, scan);
+        } else {
+          withColumnType(lty, [&](auto colType) {
+            using ColT = decltype(colType);
+            scanListSizes(static_cast<typename ColT::Reader*>(column_reader.get()), batchSize,
+                          listValueDef<typename ColT::Dst>(max_def), scan);
+          });
         }
       }
-      return vct;
+      return scan.numValues;
     }
     return ARROWERROR;
   } catch (const std::exception& e) {
@@ -521,44 +1080,45 @@ int64_t cpp_getStringColumnNullIndices(const char* filename, const char* colname
   try {
     int64_t ty = cpp_getType(filename, colname, errMsg);
     auto null_indices = (int64_t*)chpl_nulls;
-    int64_t byteSize = 0;
 
     if(ty == ARROWSTRING) {
-      std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-        parquet::ParquetFileReader::OpenFile(filename, false);
+      std::shared_ptr<CachedParquetFile> pqFile;
+      ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+      std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
 
-      std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+      std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
       int num_row_groups = file_metadata->num_row_groups();
 
+      auto idx = file_metadata -> schema() -> ColumnIndex(colname);
+      if(idx < 0) {
+        std::string dname(colname);
+        std::string fname(filename);
+        std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+      int16_t max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level();
+      if(max_def == 0)
+        return 0; // a required column has no nulls
+
+      // The nulls come from the definition levels, the values are dropped
+      const int64_t batchSize = 8192;
+      int16_t* def_lvl = readScratch.defLevels(batchSize);
+      auto values = readScratch.values<parquet::ByteArray>(batchSize);
       int64_t i = 0;
       for (int r = 0; r < num_row_groups; r++) {
-        std::shared_ptr<parquet::RowGroupReader> row_group_reader =
-          parquet_reader->RowGroup(r);
-
-        int64_t values_read = 0;
-
-        std::shared_ptr<parquet::ColumnReader> column_reader;
-
-        auto idx = file_metadata -> schema() -> ColumnIndex(colname);
-
-        if(idx < 0) {
-          std::string dname(colname);
-          std::string fname(filename);
-          std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
-          *errMsg = strdup(msg.c_str());
-          return ARROWERROR;
-        }
-        column_reader = row_group_reader->Column(idx);
-        int16_t definition_level;
+        std::shared_ptr<parquet::ColumnReader> column_reader =
+          parquet_reader->RowGroup(r)->Column(idx);
         parquet::ByteArrayReader* ba_reader =
           static_cast<parquet::ByteArrayReader*>(column_reader.get());
 
         while (ba_reader->HasNext()) {
-          parquet::ByteArray value;
-          (void)ba_reader->ReadBatch(1, &definition_level, nullptr, &value, &values_read);
-          if(values_read == 0)
-            null_indices[i] = 1;
-          i++;
+          int64_t values_read = 0;
+          int64_t levels_read = ba_reader->ReadBatch(batchSize, def_lvl, nullptr, values, &values_read);
+          for (int64_t j = 0; j < levels_read; j++)
+            if(def_lvl[j] < max_def)
+              null_indices[i+j] = 1;
+          i += levels_read;
         }
       }
       return 0;
@@ -575,10 +1135,11 @@ int cpp_readListColumnByName(const char* filename, void* chpl_arr, const char* c
     int64_t ty = cpp_getType(filename, colname, errMsg);
     if (ty == ARROWLIST){
       int64_t lty = cpp_getListType(filename, colname, errMsg);
-      std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-          parquet::ParquetFileReader::OpenFile(filename, false);
+      std::shared_ptr<CachedParquetFile> pqFile;
+      ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+      std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
 
-      std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+      std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
       int num_row_groups = file_metadata->num_row_groups();
 
       auto idx = file_metadata -> schema() -> group_node() -> FieldIndex(colname);
@@ -590,145 +1151,45 @@ int cpp_readListColumnByName(const char* filename, void* chpl_arr, const char* c
         return ARROWERROR;
       }
 
+      int16_t max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level();
+
       int64_t i = 0;
       for (int r = 0; r < num_row_groups; r++) {
         std::shared_ptr<parquet::RowGroupReader> row_group_reader =
           parquet_reader->RowGroup(r);
 
-        int64_t values_read = 0;
-        int16_t definition_level; // needed for any type that is nullable
-
         std::shared_ptr<parquet::ColumnReader> column_reader = row_group_reader->Column(idx);
-        if(lty == ARROWINT64 || lty == ARROWUINT64) {
-          auto chpl_ptr = (int64_t*)chpl_arr;
-          parquet::Int64Reader* reader =
-            static_cast<parquet::Int64Reader*>(column_reader.get());
-
-          while (reader->HasNext() && i < numElems) {
-            if((numElems - i) < batchSize)
-              batchSize = numElems - i;
-            (void)reader->ReadBatch(batchSize, nullptr, nullptr, &chpl_ptr[i], &values_read);
-            i+=values_read;
-          }
-        } else if(lty == ARROWINT32 || lty == ARROWUINT32) {
-          auto chpl_ptr = (int64_t*)chpl_arr;
-          parquet::Int32Reader* reader =
-            static_cast<parquet::Int32Reader*>(column_reader.get());
-
-          int32_t* tmpArr = (int32_t*)malloc(batchSize * sizeof(int32_t));
-          while (reader->HasNext() && i < numElems) {
-            if((numElems - i) < batchSize)
-              batchSize = numElems - i;
-            // Can't read directly into chpl_ptr because it is int64
-            (void)reader->ReadBatch(batchSize, nullptr, nullptr, tmpArr, &values_read);
-            for (int64_t j = 0; j < values_read; j++)
-              chpl_ptr[i+j] = (int64_t)tmpArr[j];
-            i+=values_read;
-          }
-          free(tmpArr);
-        } else if (lty == ARROWSTRING) {
-          int16_t definition_level; // nullable type and only reading single records in batch
+        if (lty == ARROWSTRING) {
+          // A string is present where its level is defined all the way
+          // down, empty lists and null strings have no bytes
+          int16_t* def_lvl = readScratch.defLevels(batchSize);
+          auto values = readScratch.values<parquet::ByteArray>(batchSize);
           auto chpl_ptr = (unsigned char*)chpl_arr;
           parquet::ByteArrayReader* reader =
             static_cast<parquet::ByteArrayReader*>(column_reader.get());
 
           while (reader->HasNext()) {
-            parquet::ByteArray value;
-            (void)reader->ReadBatch(1, &definition_level, nullptr, &value, &values_read);
-            // if values_read is 0, that means that it was a null value
-            if(values_read > 0 && definition_level == 3) {
-              for(int j = 0; j < value.len; j++) {
-                chpl_ptr[i] = value.ptr[j];
-                i++;
-              }
-              i++; // skip one space so the strings are null terminated with a 0
-            }
-          }
-        } else if(lty == ARROWBOOLEAN) {
-          auto chpl_ptr = (bool*)chpl_arr;
-          parquet::BoolReader* reader =
-            static_cast<parquet::BoolReader*>(column_reader.get());
-
-          while (reader->HasNext() && i < numElems) {
-            if((numElems - i) < batchSize)
-              batchSize = numElems - i;
-            (void)reader->ReadBatch(batchSize, nullptr, nullptr, &chpl_ptr[i], &values_read);
-            i+=values_read;
-          }
-        } else if(lty == ARROWFLOAT) {
-          auto chpl_ptr = (double*)chpl_arr;
-          parquet::FloatReader* reader =
-            static_cast<parquet::FloatReader*>(column_reader.get());
-          
-          while (reader->HasNext() && i < numElems) {
-            if((numElems - i) < batchSize) // adjust batchSize if needed
-              batchSize = numElems - i;
-            float* tmpArr = new float[batchSize]; // this will not include NaN values
-            int16_t* def_lvl = new int16_t[batchSize];
-            int16_t* rep_lvl = new int16_t[batchSize];
-            (void)reader->ReadBatch(batchSize, def_lvl, rep_lvl, tmpArr, &values_read);
-
-            int64_t tmp_offset = 0; // used to properly access tmp after NaN encountered
-            int64_t val_idx = 0;
-            for (int64_t j = 0; j< batchSize; j++){
-              // skip any empty segments
-              if (def_lvl[j] == 1)
-                continue;
-              
-              // Null values treated as NaN
-              if (def_lvl[j] == 2) {
-                chpl_ptr[i+val_idx] = NAN;
-                tmp_offset++; // adjustment for values array since Nulls are not included
+            int64_t values_read = 0;
+            int64_t levels_read = reader->ReadBatch(batchSize, def_lvl, nullptr, values, &values_read);
+            int64_t v = 0;
+            for (int64_t j = 0; j < levels_read; j++) {
+              if(def_lvl[j] == max_def) {
+                auto& value = values[v++];
+                memcpy(&chpl_ptr[i], value.ptr, value.len);
+                i += value.len;
+                i++; // skip one space so the strings are null terminated with a 0
               }
-              else if (def_lvl[j] == 3){ // defined value to write
-                chpl_ptr[i+val_idx] = (double)tmpArr[val_idx-tmp_offset];
-              }
-              val_idx++;
             }
-
-            i += values_read + tmp_offset; // account for values and NaNs, but not empty segments
-
-            delete[] tmpArr;
-            delete[] def_lvl;
-            delete[] rep_lvl;
-          }
-        } else if(lty == ARROWDOUBLE) {
-          auto chpl_ptr = (double*)chpl_arr;
-          parquet::DoubleReader* reader =
-            static_cast<parquet::DoubleReader*>(column_reader.get());
-
-          while (reader->HasNext() && i < numElems) {
-            if((numElems - i) < batchSize) // adjust batchSize if needed
-              batchSize = numElems - i;
-            double* tmpArr = new double[batchSize]; // NaNs not included here
-            int16_t* def_lvl = new int16_t[batchSize];
-            int16_t* rep_lvl = new int16_t[batchSize];
-            (void)reader->ReadBatch(batchSize, def_lvl, rep_lvl, tmpArr, &values_read);
-            
-            int64_t tmp_offset = 0; // used to properly access tmp after NaN encountered
-            int64_t val_idx = 0;
-            for (int64_t j = 0; j< batchSize; j++){
-              // skip any empty segments
-              if (def_lvl[j] == 1)
-                continue;
-              
-              // Null values treated as NaN
-              if (def_lvl[j] == 2) {
-                chpl_ptr[i+val_idx] = NAN;
-                tmp_offset++; // adjustment for values array since Nulls are not included
-              }
-              else if (def_lvl[j] == 3){ // defined value to write
-                chpl_ptr[i+val_idx] = (double)tmpArr[val_idx-tmp_offset];
-              }
-              val_idx++;
-            }
-
-            i += values_read + tmp_offset; // account for values and NaNs, but not empty segments
-
-            delete[] tmpArr;
-            delete[] def_lvl;
-            delete[] rep_lvl;
           }
+        } else {
+          withColumnType(lty, [&](auto colType) {
+            using ColT = decltype(colType);
+            using DstT = typename ColT::Dst;
+            auto reader = static_cast<typename ColT::Reader*>(column_reader.get());
+            i += readValues<typename ColT::Reader, typename ColT::Val>(
+              reader, max_def, listValueDef<DstT>(max_def), true, (DstT*)chpl_arr + i,
+              nullptr, 0, numElems - i, batchSize);
+          });
         }
       }
       return 0;
@@ -740,196 +1201,1221 @@ int cpp_readListColumnByName(const char* filename, void* chpl_arr, const char* c
   }
 }
 
-int cpp_readColumnByName(const char* filename, void* chpl_arr, const char* colname, int64_t numElems, int64_t startIdx, int64_t batchSize, int64_t byteLength, char** errMsg) {
+// Find the row groups [firstRG, lastRG) that hold the rows
+// [startIdx, startIdx+numElems) using the row counts in the footer, so
+// that a reader can start at the first row group it needs instead of
+// skipping over every row before it. rgSkip is set to the number of
+// rows to skip at the start of firstRG.
+void getRowGroupRange(const std::shared_ptr<parquet::FileMetaData>& file_metadata,
+                      int64_t startIdx, int64_t numElems,
+                      int* firstRG, int* lastRG, int64_t* rgSkip) {
+  int num_row_groups = file_metadata->num_row_groups();
+  int64_t endIdx = startIdx + numElems;
+  int64_t rgStart = 0; // index of the first row of row group r
+  *firstRG = num_row_groups;
+  *lastRG = num_row_groups;
+  *rgSkip = 0;
+  for (int r = 0; r < num_row_groups; r++) {
+    int64_t rgEnd = rgStart + file_metadata->RowGroup(r)->num_rows();
+    if (*firstRG == num_row_groups && rgEnd > startIdx) {
+      *firstRG = r;
+      *rgSkip = startIdx - rgStart;
+    }
+    if (rgEnd >= endIdx) {
+      *lastRG = r + 1;
+      break;
+    }
+    rgStart = rgEnd;
+  }
+}
+
+// A row group overlapping a read, along with the rows to read from it
+// and where they land in the destination array
+struct RowGroupSlice {
+  int rg;        // row group index
+  int64_t skip;  // rows to skip at the start of the row group
+  int64_t count; // rows to read from the row group
+  int64_t dst;   // destination index of the first row read
+};
+
+std::vector<RowGroupSlice> getRowGroupSlices(const std::shared_ptr<parquet::FileMetaData>& file_metadata,
+                                             int64_t startIdx, int64_t numElems) {
+  int firstRG, lastRG;
+  int64_t rgSkip;
+  getRowGroupRange(file_metadata, startIdx, numElems, &firstRG, &lastRG, &rgSkip);
+
+  std::vector<RowGroupSlice> slices;
+  int64_t dst = 0;
+  for (int r = firstRG; r < lastRG; r++) {
+    int64_t skip = (r == firstRG) ? rgSkip : 0;
+    int64_t count = std::min(file_metadata->RowGroup(r)->num_rows() - skip, numElems - dst);
+    slices.push_back({r, skip, count, dst});
+    dst += count;
+  }
+  return slices;
+}
+
+// Call fn(k) for every k in [0, n), handing the indices out to up to
+// numThreads threads (including this one). The first exception raised on
+// any thread is rethrown here once all of them finish.
+void parallelFor(int64_t n, int64_t numThreads, const std::function<void(int64_t)>& fn) {
+  if(numThreads <= 1 || n <= 1) {
+    for (int64_t k = 0; k < n; k++)
+      fn(k);
+    return;
+  }
+
+  std::atomic<int64_t> next(0);
+  std::mutex errMtx;
+  std::string err;
+  auto worker = [&]() {
+    for (int64_t k = next++; k < n; k = next++) {
+      try {
+        fn(k);
+      } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(errMtx);
+        if(err.empty())
+          err = e.what();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  int64_t nThreads = std::min(numThreads, n);
+  for (int64_t t = 1; t < nThreads; t++)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads)
+    t.join();
+
+  if(!err.empty())
+    throw std::runtime_error(err);
+}
+
+// Call fn on every slice. Since slices land in disjoint parts of the
+// destination they can be read in any order.
+void forEachRowGroupSlice(const std::vector<RowGroupSlice>& slices, int64_t numThreads,
+                          const std::function<void(const RowGroupSlice&)>& fn) {
+  parallelFor(slices.size(), numThreads, [&](int64_t k) { fn(slices[k]); });
+}
+
+// A reader of file for the given columns of the row groups in slices,
+// with their column chunks pre-buffered if that is turned on
+std::shared_ptr<parquet::ParquetFileReader> openSliceReader(const std::shared_ptr<CachedParquetFile>& file,
+                                                            const std::vector<RowGroupSlice>& slices,
+                                                            const std::vector<int>& columns) {
+  if(!parquetPreBuffer.load() || slices.empty())
+    return file->reader;
+  std::shared_ptr<parquet::ParquetFileReader> reader =
+    parquet::ParquetFileReader::Open(file->source, parquetReaderProperties(), file->metadata);
+  std::vector<int> rowGroups;
+  for (auto& slice : slices)
+    rowGroups.push_back(slice.rg);
+  arrow::io::CacheOptions options = arrow::io::CacheOptions::Defaults();
+  options.hole_size_limit = parquetHoleSizeLimit.load();
+  options.range_size_limit = parquetRangeSizeLimit.load();
+  reader->PreBuffer(rowGroups, columns, arrow::io::default_io_context(), options);
+  return reader;
+}
+
+// Read count rows of column idx from a row group, starting skip rows into
+// the row group, into chpl_arr starting at element dstIdx. If validity
+// isn't null their bits are set in it, starting at bit dstIdx. Time
+// columns are multiplied by timeMultiplier to get nanoseconds.
+// Every type handled here has a fixed width in the Chapel array, so
+// each row group can be read independently of the others.
+void readColumnRowGroup(parquet::RowGroupReader* row_group_reader,
+                        int idx, int64_t ty, int16_t max_def, void* chpl_arr,
+                        uint8_t* validity, int64_t dstIdx, int64_t rgSkip, int64_t numElems,
+                        int64_t batchSize, int64_t byteLength, int64_t timeMultiplier) {
+  std::shared_ptr<parquet::ColumnReader> column_reader =
+    row_group_reader->Column(idx);
+
+  if(withColumnType(ty, [&](auto colType) {
+        using ColT = decltype(colType);
+        auto reader = static_cast<typename ColT::Reader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readValues<typename ColT::Reader, typename ColT::Val>(
+          reader, max_def, 0, false, (typename ColT::Dst*)chpl_arr + dstIdx,
+          validity, dstIdx, numElems, batchSize);
+      }))
+    return;
+
+  // Time columns are int64 nanoseconds in Chapel, whatever they are
+  // stored as
+  if(ty == ARROWTIMESTAMP || ty == ARROWDATE || ty == ARROWDURATION) {
+    auto chpl_ptr = (int64_t*)chpl_arr + dstIdx;
+    switch (column_reader->descr()->physical_type()) {
+      case parquet::Type::INT32: {
+        auto reader = static_cast<parquet::Int32Reader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readValues<parquet::Int32Reader, int32_t>(reader, max_def, 0, false, chpl_ptr, validity,
+                                                        dstIdx, numElems, batchSize, timeMultiplier);
+        break;
+      }
+      case parquet::Type::INT64: {
+        auto reader = static_cast<parquet::Int64Reader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readValues<parquet::Int64Reader, int64_t>(reader, max_def, 0, false, chpl_ptr, validity,
+                                                        dstIdx, numElems, batchSize, timeMultiplier);
+        break;
+      }
+      case parquet::Type::INT96: {
+        auto reader = static_cast<parquet::Int96Reader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readValues<parquet::Int96Reader, parquet::Int96>(reader, max_def, 0, false, chpl_ptr, validity,
+                                                               dstIdx, numElems, batchSize);
+        break;
+      }
+      default:
+        throw std::runtime_error("Unsupported physical type for time column: " +
+                                 column_reader->descr()->name());
+    }
+    return;
+  }
+
+  // Decimals are read as their unscaled integer values, the scale is in
+  // the column's metadata
+  if(ty == ARROWDECIMAL) {
+    const parquet::ColumnDescriptor* descr = column_reader->descr();
+    int numLimbs = decimalNumLimbs(descr->type_precision());
+    auto chpl_ptr = (uint64_t*)chpl_arr + dstIdx * numLimbs;
+    switch (descr->physical_type()) {
+      // only used up to precision 9 and 18, so always read as int64
+      case parquet::Type::INT32: {
+        auto reader = static_cast<parquet::Int32Reader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readValues<parquet::Int32Reader, int32_t>(reader, max_def, 0, false, (int64_t*)chpl_ptr,
+                                                        validity, dstIdx, numElems, batchSize);
+        break;
+      }
+      case parquet::Type::INT64: {
+        auto reader = static_cast<parquet::Int64Reader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readValues<parquet::Int64Reader, int64_t>(reader, max_def, 0, false, (int64_t*)chpl_ptr,
+                                                        validity, dstIdx, numElems, batchSize);
+        break;
+      }
+      case parquet::Type::FIXED_LEN_BYTE_ARRAY: {
+        auto reader = static_cast<parquet::FixedLenByteArrayReader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readDecimals(reader, max_def, byteLength, numLimbs, chpl_ptr,
+                           validity, dstIdx, numElems, batchSize);
+        break;
+      }
+      case parquet::Type::BYTE_ARRAY: {
+        auto reader = static_cast<parquet::ByteArrayReader*>(column_reader.get());
+        reader->Skip(rgSkip);
+        (void)readDecimals(reader, max_def, byteLength, numLimbs, chpl_ptr,
+                           validity, dstIdx, numElems, batchSize);
+        break;
+      }
+      default:
+        throw std::runtime_error("Unsupported physical type for decimal column: " + descr->name());
+    }
+  }
+}
+
+int cpp_readColumnByName(const char* filename, void* chpl_arr, const char* colname, int64_t numElems, int64_t startIdx, int64_t batchSize, int64_t byteLength, int64_t numThreads, char** errMsg) {
   try {
     int64_t ty = cpp_getType(filename, colname, errMsg);
   
-    std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
-      parquet::ParquetFileReader::OpenFile(filename, false);
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
 
-    std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
-    int num_row_groups = file_metadata->num_row_groups();
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
 
-    int64_t i = 0;
-    for (int r = 0; r < num_row_groups; r++) {
-      std::shared_ptr<parquet::RowGroupReader> row_group_reader =
-        parquet_reader->RowGroup(r);
-
-      int64_t values_read = 0;
+    auto idx = file_metadata -> schema() -> ColumnIndex(colname);
+    if(idx < 0) {
+      std::string dname(colname);
+      std::string fname(filename);
+      std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
+    }
+    auto max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level(); // needed to determine if nulls are allowed
+    int64_t timeMultiplier = nanosPerUnit(storedTimeUnit(file_metadata -> schema() -> Column(idx),
+                                                         pqFile -> schema -> GetFieldByName(colname) -> type()));
 
-      std::shared_ptr<parquet::ColumnReader> column_reader;
+    // String and list columns have readers of their own
+    if(ty == ARROWSTRING || ty == ARROWLIST) {
+      std::string dname(colname);
+      std::string msg = "Dataset: " + dname + " is not a fixed width column and must be read with " +
+        (ty == ARROWSTRING ? "c_readStrColumnByName" : "c_readListColumnByName");
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
+    }
 
-      auto idx = file_metadata -> schema() -> ColumnIndex(colname);
-      auto max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level(); // needed to determine if nulls are allowed
+    // Only the row groups overlapping the slice are visited
+    auto slices = getRowGroupSlices(file_metadata, startIdx, numElems);
+    parquet_reader = openSliceReader(pqFile, slices, {idx});
+    forEachRowGroupSlice(slices, numThreads, [&](const RowGroupSlice& slice) {
+      std::shared_ptr<parquet::RowGroupReader> row_group_reader =
+        parquet_reader->RowGroup(slice.rg);
+      readColumnRowGroup(row_group_reader.get(), idx, ty, max_def, chpl_arr, nullptr,
+                         slice.dst, slice.skip, slice.count, batchSize, byteLength, timeMultiplier);
+    });
+    return 0;
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
 
-      if(idx < 0) {
-        std::string dname(colname);
+int cpp_readColumnsByName(const char* filename, void** chpl_arrs, void** chpl_validities,
+                          void* column_names, void* byteLengths, int64_t numCols,
+                          int64_t numElems, int64_t startIdx, int64_t batchSize,
+                          int64_t numThreads, char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
+
+    auto cname_ptr = (char**)column_names;
+    auto blen_ptr = (int64_t*)byteLengths;
+    std::vector<int> idxs(numCols);
+    std::vector<int64_t> tys(numCols);
+    std::vector<int16_t> max_defs(numCols);
+    std::vector<int64_t> timeMultipliers(numCols);
+    for (int64_t c = 0; c < numCols; c++) {
+      tys[c] = cpp_getType(filename, cname_ptr[c], errMsg);
+      if(tys[c] == ARROWERROR)
+        return ARROWERROR;
+      if(tys[c] == ARROWSTRING || tys[c] == ARROWLIST) {
+        std::string dname(cname_ptr[c]);
+        std::string msg = "Dataset: " + dname + " is not a fixed width column and must be read with " +
+          (tys[c] == ARROWSTRING ? "c_readStrColumnByName" : "c_readListColumnByName");
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+      idxs[c] = file_metadata -> schema() -> ColumnIndex(cname_ptr[c]);
+      if(idxs[c] < 0) {
+        std::string dname(cname_ptr[c]);
         std::string fname(filename);
         std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
         *errMsg = strdup(msg.c_str());
         return ARROWERROR;
       }
-      
-      column_reader = row_group_reader->Column(idx);
-
-      // Since int64 and uint64 Arrow dtypes share a physical type and only differ
-      // in logical type, they must be read from the file in the same way
-      if(ty == ARROWINT64 || ty == ARROWUINT64) {
-        auto chpl_ptr = (int64_t*)chpl_arr;
-        parquet::Int64Reader* reader =
-          static_cast<parquet::Int64Reader*>(column_reader.get());
-        startIdx -= reader->Skip(startIdx);
-
-        while (reader->HasNext() && i < numElems) {
-          if((numElems - i) < batchSize)
-            batchSize = numElems - i;
-          (void)reader->ReadBatch(batchSize, nullptr, nullptr, &chpl_ptr[i], &values_read);
-          i+=values_read;
-        }
-      } else if(ty == ARROWINT32 || ty == ARROWUINT32) {
-        auto chpl_ptr = (int64_t*)chpl_arr;
-        parquet::Int32Reader* reader =
-          static_cast<parquet::Int32Reader*>(column_reader.get());
-        startIdx -= reader->Skip(startIdx);
-
-        int32_t* tmpArr = (int32_t*)malloc(batchSize * sizeof(int32_t));
-        while (reader->HasNext() && i < numElems) {
-          if((numElems - i) < batchSize)
-            batchSize = numElems - i;
-          // Can't read directly into chpl_ptr because it is int64
-          (void)reader->ReadBatch(batchSize, nullptr, nullptr, tmpArr, &values_read);
-          for (int64_t j = 0; j < values_read; j++)
-            chpl_ptr[i+j] = (int64_t)tmpArr[j];
-          i+=values_read;
+      max_defs[c] = file_metadata -> schema() -> Column(idxs[c]) -> max_definition_level();
+      timeMultipliers[c] = nanosPerUnit(storedTimeUnit(file_metadata -> schema() -> Column(idxs[c]),
+                                                       pqFile -> schema -> GetFieldByName(cname_ptr[c]) -> type()));
+    }
+
+    // Open each row group once and read all of the requested columns from it
+    auto slices = getRowGroupSlices(file_metadata, startIdx, numElems);
+    parquet_reader = openSliceReader(pqFile, slices, idxs);
+    forEachRowGroupSlice(slices, numThreads, [&](const RowGroupSlice& slice) {
+      std::shared_ptr<parquet::RowGroupReader> row_group_reader =
+        parquet_reader->RowGroup(slice.rg);
+      for (int64_t c = 0; c < numCols; c++)
+        readColumnRowGroup(row_group_reader.get(), idxs[c], tys[c], max_defs[c], chpl_arrs[c],
+                           chpl_validities ? (uint8_t*)chpl_validities[c] : nullptr,
+                           slice.dst, slice.skip, slice.count, batchSize, blen_ptr[c],
+                           timeMultipliers[c]);
+    });
+    return 0;
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
+
+int64_t cpp_readStrColumnByName(const char* filename, const char* colname, void* chpl_lengths,
+                                void* chpl_validity, void** values, int64_t numElems,
+                                int64_t startIdx, int64_t batchSize, char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
+
+    auto idx = file_metadata -> schema() -> ColumnIndex(colname);
+    if(idx < 0) {
+      std::string dname(colname);
+      std::string fname(filename);
+      std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
+    }
+    auto max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level();
+    auto slices = getRowGroupSlices(file_metadata, startIdx, numElems);
+    parquet_reader = openSliceReader(pqFile, slices, {idx});
+
+    // The uncompressed size of the column chunks read plus a null
+    // terminator per row is an upper bound on the bytes for plain encoded
+    // pages, so it is used as the initial size of the buffer, which grows
+    // if needed
+    int64_t capacity = numElems;
+    for (auto& slice : slices)
+      capacity += file_metadata->RowGroup(slice.rg)->ColumnChunk(idx)->total_uncompressed_size();
+    std::unique_ptr<uint8_t, decltype(&free)> buf((uint8_t*)malloc(std::max(capacity, (int64_t)1)), &free);
+    if(!buf)
+      throw std::bad_alloc();
+
+    auto lengths = (int64_t*)chpl_lengths;
+    auto validity = (uint8_t*)chpl_validity;
+    std::vector<parquet::ByteArray> string_values(batchSize);
+    std::vector<int16_t> def_lvl(batchSize);
+    int64_t numBytes = 0;
+    int64_t i = 0;
+    for (auto& slice : slices) {
+      std::shared_ptr<parquet::RowGroupReader> row_group_reader =
+        parquet_reader->RowGroup(slice.rg);
+      std::shared_ptr<parquet::ColumnReader> column_reader =
+        row_group_reader->Column(idx);
+      parquet::ByteArrayReader* reader =
+        static_cast<parquet::ByteArrayReader*>(column_reader.get());
+
+      if(slice.skip > 0)
+        reader->Skip(slice.skip);
+      int64_t end = slice.dst + slice.count;
+      while (reader->HasNext() && i < end) {
+        int64_t values_read = 0;
+        int64_t levels_read = reader->ReadBatch(std::min(batchSize, end - i), def_lvl.data(), nullptr,
+                                                string_values.data(), &values_read);
+        int64_t batchBytes = levels_read;
+        for (int64_t v = 0; v < values_read; v++)
+          batchBytes += string_values[v].len;
+        if(numBytes + batchBytes > capacity) {
+          capacity = std::max(2 * capacity, numBytes + batchBytes);
+          auto grown = (uint8_t*)realloc(buf.get(), capacity);
+          if(!grown)
+            throw std::bad_alloc();
+          buf.release();
+          buf.reset(grown);
         }
-        free(tmpArr);
-      } else if(ty == ARROWBOOLEAN) {
-        auto chpl_ptr = (bool*)chpl_arr;
-        parquet::BoolReader* reader =
-          static_cast<parquet::BoolReader*>(column_reader.get());
-        startIdx -= reader->Skip(startIdx);
-
-        while (reader->HasNext() && i < numElems) {
-          if((numElems - i) < batchSize)
-            batchSize = numElems - i;
-          (void)reader->ReadBatch(batchSize, nullptr, nullptr, &chpl_ptr[i], &values_read);
-          i+=values_read;
+
+        if(validity)
+          setValidityBits(validity, i, (max_def != 0) ? def_lvl.data() : nullptr, max_def, levels_read);
+
+        // nulls are read as empty strings
+        uint8_t* dst = buf.get();
+        int64_t v = 0;
+        for (int64_t j = 0; j < levels_read; j++) {
+          if(max_def == 0 || def_lvl[j] == max_def) {
+            auto& value = string_values[v++];
+            memcpy(dst + numBytes, value.ptr, value.len);
+            numBytes += value.len;
+            lengths[i] = value.len + 1;
+          } else {
+            lengths[i] = 1;
+          }
+          dst[numBytes++] = 0;
+          i++;
         }
-      } else if(ty == ARROWSTRING) {
-        auto numCols = file_metadata -> num_columns();
-        int16_t definition_level; // nullable type and only reading single records in batch
-        auto chpl_ptr = (unsigned char*)chpl_arr;
-        parquet::ByteArrayReader* reader =
-          static_cast<parquet::ByteArrayReader*>(column_reader.get());
+      }
+    }
+    *values = buf.release();
+    return numBytes;
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
 
-        while (reader->HasNext()) {
-          std::vector<parquet::ByteArray> string_values(batchSize);
-          std::vector<int16_t> definition_level(batchSize);
-          (void)reader->ReadBatch(batchSize, definition_level.data(), nullptr, string_values.data(), &values_read);
+int cpp_isDictionaryEncoded(const char* filename, const char* colname, char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
 
-          int string_index = 0;
-          for (int idx = 0; idx < definition_level.size(); idx++) {
-            auto lvl = definition_level[idx];
-            if(lvl > 0 || numCols > 1) {
-              auto value = string_values[string_index];
-              for(int j = 0; j < value.len; j++) {
-                chpl_ptr[i] = value.ptr[j];
-                i++;
-              }
-              string_index++;
+    auto idx = file_metadata -> schema() -> ColumnIndex(colname);
+    if(idx < 0) {
+      std::string dname(colname);
+      std::string fname(filename);
+      std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
+    }
+    if(file_metadata -> schema() -> Column(idx) -> physical_type() != parquet::Type::BYTE_ARRAY)
+      return 0;
+
+    // Every data page of every column chunk has to be dictionary encoded,
+    // a writer falls back to plain encoding once a dictionary gets too big
+    for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+      auto col_metadata = file_metadata->RowGroup(r)->ColumnChunk(idx);
+      if(!col_metadata->has_dictionary_page())
+        return 0;
+      auto& encoding_stats = col_metadata->encoding_stats();
+      if(encoding_stats.empty()) // written without page statistics, can't tell
+        return 0;
+      for (auto& stats : encoding_stats) {
+        if((stats.page_type == parquet::PageType::DATA_PAGE ||
+            stats.page_type == parquet::PageType::DATA_PAGE_V2) &&
+           stats.encoding != parquet::Encoding::PLAIN_DICTIONARY &&
+           stats.encoding != parquet::Encoding::RLE_DICTIONARY)
+          return 0;
+      }
+    }
+    return 1;
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
+
+int64_t cpp_readDictColumnByName(const char* filename, void* chpl_codes, const char* colname,
+                                 int64_t numElems, int64_t startIdx, int64_t batchSize,
+                                 void** dictValues, int64_t* dictNumBytes, char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<parquet::ParquetFileReader> parquet_reader = pqFile->reader;
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
+
+    auto idx = file_metadata -> schema() -> ColumnIndex(colname);
+    if(idx < 0) {
+      std::string dname(colname);
+      std::string fname(filename);
+      std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
+    }
+    auto max_def = file_metadata -> schema() -> Column(idx) -> max_definition_level();
+
+    // Each row group has its own dictionary, so they are merged into one
+    // dictionary for the slice as we go. The dictionary is returned as
+    // null terminated strings, the same layout as Strings values.
+    auto chpl_ptr = (int64_t*)chpl_codes;
+    std::unordered_map<std::string, int64_t> dictIdx;
+    std::vector<char> dictBytes;
+    std::vector<int16_t> def_lvl(batchSize);
+    std::vector<int32_t> indices(batchSize);
+
+    for (auto& slice : getRowGroupSlices(file_metadata, startIdx, numElems)) {
+      std::shared_ptr<parquet::RowGroupReader> row_group_reader =
+        parquet_reader->RowGroup(slice.rg);
+      std::shared_ptr<parquet::ColumnReader> column_reader =
+        row_group_reader->ColumnWithExposeEncoding(idx, parquet::ExposedEncoding::DICTIONARY);
+      if(column_reader->GetExposedEncoding() != parquet::ExposedEncoding::DICTIONARY) {
+        std::string dname(colname);
+        std::string fname(filename);
+        std::string msg = "Dataset: " + dname + " is not dictionary encoded in file: " + fname;
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+      parquet::ByteArrayReader* reader =
+        static_cast<parquet::ByteArrayReader*>(column_reader.get());
+
+      std::vector<int64_t> remap; // row group dictionary index -> slice dictionary index
+      int64_t toSkip = slice.skip;
+      int64_t i = slice.dst;
+      int64_t end = slice.dst + slice.count;
+      while (reader->HasNext() && i < end) {
+        int64_t toRead = std::min(batchSize, toSkip > 0 ? toSkip : end - i);
+        const parquet::ByteArray* dict = nullptr;
+        int32_t dict_len = 0;
+        int64_t indices_read = 0;
+        int64_t levels_read = reader->ReadBatchWithDictionary(toRead, def_lvl.data(), nullptr,
+                                                              indices.data(), &indices_read,
+                                                              &dict, &dict_len);
+        if(remap.empty() && dict_len > 0) {
+          remap.resize(dict_len);
+          for (int32_t d = 0; d < dict_len; d++) {
+            std::string value((const char*)dict[d].ptr, dict[d].len);
+            auto it = dictIdx.find(value);
+            if(it == dictIdx.end()) {
+              dictBytes.insert(dictBytes.end(), dict[d].ptr, dict[d].ptr + dict[d].len);
+              dictBytes.push_back(0);
+              it = dictIdx.emplace(std::move(value), (int64_t)dictIdx.size()).first;
             }
-            i++; // skip one space so the strings are null terminated with a 0
+            remap[d] = it->second;
           }
         }
-      } else if(ty == ARROWFLOAT) {
-        auto chpl_ptr = (double*)chpl_arr;
-        parquet::FloatReader* reader =
-          static_cast<parquet::FloatReader*>(column_reader.get());
-        startIdx -= reader->Skip(startIdx);
-        
-        while (reader->HasNext() && i < numElems) {
-          if((numElems - i) < batchSize) // adjust batchSize if needed
-            batchSize = numElems - i;
-
-          // define def and rep level tracking to the batch size. This is required to detect NaN
-          int16_t* def_lvl = new int16_t[batchSize] { 0 };
-          int16_t* rep_lvl = new int16_t[batchSize] { 0 };
-          
-          float* tmpArr = new float[batchSize] { 0 }; // this will not include NaN values
-          
-          int64_t idx_adjust = 0; // adjustment for NaNs encountered so index into tmpArr is correct
-          (void)reader->ReadBatch(batchSize, def_lvl, rep_lvl, tmpArr, &values_read);
-          // copy values to Chapel array. Convert to double if not NaN
-          for (int64_t j = 0; j < batchSize; j++){
-            // when definition level is 0, mean Null which equated to NaN here unless 0 is the max meaning no null/nan values
-            if (max_def != 0 && def_lvl[j] == 0) {
-              chpl_ptr[i] = NAN;
-              idx_adjust++; // account for the NaN at the indexes after because tmpArr only stores values
-            } else {
-              chpl_ptr[i] = (double)tmpArr[j-idx_adjust]; // cast to double for Chapel
-            }
-            i++;
-          }
-          delete[] def_lvl;
-          delete[] rep_lvl;
+        if(toSkip > 0) {
+          toSkip -= levels_read;
+          continue;
         }
-      } else if(ty == ARROWDOUBLE) {
-        auto chpl_ptr = (double*)chpl_arr;
-        parquet::DoubleReader* reader =
-          static_cast<parquet::DoubleReader*>(column_reader.get());
-        startIdx -= reader->Skip(startIdx);
-
-        while (reader->HasNext() && i < numElems) {
-          if((numElems - i) < batchSize) // adjust batchSize if needed
-            batchSize = numElems - i;
-
-          // define def and rep level tracking to the batch size. This is required to detect NaN
-          int16_t* def_lvl = new int16_t[batchSize] { 0 };
-          int16_t* rep_lvl = new int16_t[batchSize] { 0 };
-
-          double* tmpArr = new double[batchSize] { 0 }; // this will not include NaN values
-          int64_t idx_adjust = 0; // adjustment for NaNs encountered so index into tmpArr is correct
-          (void)reader->ReadBatch(batchSize, def_lvl, rep_lvl, tmpArr, &values_read);
-          // copy values into our Chapel array
-          for (int64_t j = 0; j < batchSize; j++){
-            // when definition level is 0, mean Null which equated to NaN here unless 0 is the max meaning no null/nan values
-            if (max_def != 0 && def_lvl[j] == 0) {
-              chpl_ptr[i] = NAN;
-              idx_adjust++; // account for the NaN at the indexes after because tmpArr only stores values
-            } else {
-              chpl_ptr[i] = tmpArr[j-idx_adjust];
-            }
-            i++;
-          }
-          delete[] tmpArr;
-          delete[] def_lvl;
-          delete[] rep_lvl;
+        // nulls are given the code -1
+        int64_t v = 0;
+        for (int64_t j = 0; j < levels_read; j++) {
+          if(max_def > 0 && def_lvl[j] < max_def)
+            chpl_ptr[i++] = -1;
+          else
+            chpl_ptr[i++] = remap[indices[v++]];
         }
-      } else if(ty == ARROWDECIMAL) {
-        auto chpl_ptr = (double*)chpl_arr;
-        parquet::FixedLenByteArray value;
-        parquet::FixedLenByteArrayReader* reader =
-          static_cast<parquet::FixedLenByteArrayReader*>(column_reader.get());
-        startIdx -= reader->Skip(startIdx);
-
-        while (reader->HasNext() && i < numElems) {
-          (void)reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
-          arrow::Decimal128 v;
-          PARQUET_ASSIGN_OR_THROW(v,
-                                  ::arrow::Decimal128::FromBigEndian(value.ptr, byteLength));
-
-          chpl_ptr[i] = v.ToDouble(0);
-          i+=values_read;
+      }
+    }
+
+    auto values = malloc(std::max(dictBytes.size(), (size_t)1));
+    if(!values)
+      throw std::bad_alloc();
+    memcpy(values, dictBytes.data(), dictBytes.size());
+    *dictValues = values;
+    *dictNumBytes = dictBytes.size();
+    return dictIdx.size();
+  } catch (const std::exception& e) {
+    *errMsg = strdup(e.what());
+    return ARROWERROR;
+  }
+}
+
+/*
+  Row group pruning
+  -----------------
+  A filter is a list of predicates on flat columns which all have to hold
+  for a row to match. Each row group is checked against the min/max
+  statistics of the predicate columns in the footer, and row groups that
+  can't hold a matching row are dropped. When the file has a page index
+  and Arrow is 12 or later, the pages of the remaining row groups are
+  checked the same way so that only the rows of pages that may match are
+  kept. This only narrows down
+  the rows that have to be read, the rows kept still need to be filtered.
+*/
+struct ColumnPredicate {
+  int col;          // leaf column index in the file
+  int64_t kind;     // PREDRANGE, PREDMIN, PREDMAX or PREDIN
+  bool isUnsigned;  // integers stored as unsigned
+  int64_t multiplier; // stored time values to nanoseconds, 1 otherwise
+  std::vector<std::string> values; // [low, high] for PREDRANGE, otherwise the values
+  std::vector<long double> numbers; // values parsed once, for numeric columns
+};
+
+// Numeric values are compared as long double, which holds every int64,
+// uint64 and double exactly. Strings are compared bytewise, which is the
+// order Parquet uses for their statistics.
+template <typename K>
+const std::vector<K>& predicateValues(const ColumnPredicate& pred);
+
+template <>
+const std::vector<long double>& predicateValues<long double>(const ColumnPredicate& pred) {
+  return pred.numbers;
+}
+
+template <>
+const std::vector<std::string>& predicateValues<std::string>(const ColumnPredicate& pred) {
+  return pred.values;
+}
+
+// Whether a value in [min, max] may satisfy pred
+template <typename K>
+bool predicateMayMatch(const K& min, const K& max, const ColumnPredicate& pred) {
+  auto& values = predicateValues<K>(pred);
+  switch (pred.kind) {
+    case PREDRANGE:
+      return !(max < values[0]) && !(values[1] < min);
+    case PREDMIN:
+      return !(max < values[0]);
+    case PREDMAX:
+      return !(values[0] < min);
+    default:
+      for (auto& v : values) {
+        if(!(v < min) && !(max < v))
+          return true;
+      }
+      return false;
+  }
+}
+
+// Same as above, with min and max as they are stored for the physical type
+template <typename DType>
+bool statsMayMatch(const typename DType::c_type& min, const typename DType::c_type& max,
+                   const ColumnPredicate& pred) {
+  using T = typename DType::c_type;
+  if constexpr (std::is_same<T, parquet::ByteArray>::value) {
+    return predicateMayMatch(std::string((const char*)min.ptr, min.len),
+                             std::string((const char*)max.ptr, max.len), pred);
+  } else if constexpr (std::is_integral<T>::value) {
+    using U = typename std::make_unsigned<T>::type;
+    if(pred.isUnsigned)
+      return predicateMayMatch((long double)(U)min, (long double)(U)max, pred);
+    // time columns are filtered in the nanoseconds they are read as
+    return predicateMayMatch((long double)min * pred.multiplier,
+                             (long double)max * pred.multiplier, pred);
+  } else {
+    return predicateMayMatch((long double)min, (long double)max, pred);
+  }
+}
+
+template <typename DType>
+bool rowGroupMayMatch(const std::shared_ptr<parquet::Statistics>& stats, const ColumnPredicate& pred) {
+  if(!stats)
+    return true;
+  // nulls never match, so a chunk of only nulls can be dropped
+  if(stats->HasNullCount() && stats->num_values() == 0 && stats->null_count() > 0)
+    return false;
+  if(!stats->HasMinMax())
+    return true;
+  auto typed = std::static_pointer_cast<parquet::TypedStatistics<DType>>(stats);
+  return statsMayMatch<DType>(typed->min(), typed->max(), pred);
+}
+
+typedef std::vector<std::pair<int64_t, int64_t>> RowRanges; // [start, end) pairs
+
+RowRanges intersectRowRanges(const RowRanges& a, const RowRanges& b) {
+  RowRanges out;
+  size_t i = 0, j = 0;
+  while (i < a.size() && j < b.size()) {
+    int64_t start = std::max(a[i].first, b[j].first);
+    int64_t end = std::min(a[i].second, b[j].second);
+    if(start < end)
+      out.push_back({start, end});
+    if(a[i].second < b[j].second)
+      i++;
+    else
+      j++;
+  }
+  return out;
+}
+
+#if ARROW_VERSION_MAJOR >= 12
+// The rows of a row group in pages that may satisfy pred
+template <typename DType>
+RowRanges pageRowRanges(const parquet::ColumnIndex& columnIndex, const parquet::OffsetIndex& offsetIndex,
+                        int64_t numRows, const ColumnPredicate& pred) {
+  auto& typed = static_cast<const parquet::TypedColumnIndex<DType>&>(columnIndex);
+  auto& pages = offsetIndex.page_locations();
+  auto& nonNullPages = typed.non_null_page_indices();
+  RowRanges out;
+  for (size_t k = 0; k < nonNullPages.size(); k++) {
+    size_t p = nonNullPages[k];
+    if(!statsMayMatch<DType>(typed.min_values()[k], typed.max_values()[k], pred))
+      continue;
+    int64_t start = pages[p].first_row_index;
+    int64_t end = (p + 1 < pages.size()) ? pages[p + 1].first_row_index : numRows;
+    if(!out.empty() && out.back().second == start)
+      out.back().second = end;
+    else
+      out.push_back({start, end});
+  }
+  return out;
+}
+#endif
+
+// Dispatch on the physical type of a predicate column. Booleans and
+// fixed length byte arrays (decimals) are never pruned.
+template <typename F>
+bool withPredicateType(parquet::Type::type physical_type, F&& fn) {
+  switch (physical_type) {
+    case parquet::Type::INT32: fn(parquet::Int32Type()); return true;
+    case parquet::Type::INT64: fn(parquet::Int64Type()); return true;
+    case parquet::Type::FLOAT: fn(parquet::FloatType()); return true;
+    case parquet::Type::DOUBLE: fn(parquet::DoubleType()); return true;
+    case parquet::Type::BYTE_ARRAY: fn(parquet::ByteArrayType()); return true;
+    default: return false;
+  }
+}
+
+int64_t cpp_getFilteredRowRanges(const char* filename, void* column_names, void* pred_kinds,
+                                 void* pred_num_values, void* pred_values, int64_t numPreds,
+                                 void** ranges, char** errMsg) {
+  try {
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<parquet::FileMetaData> file_metadata = pqFile->metadata;
+    auto schema = file_metadata->schema();
+
+    auto names = (char**)column_names;
+    auto kinds = (int64_t*)pred_kinds;
+    auto numValues = (int64_t*)pred_num_values;
+    auto values = (char**)pred_values;
+    std::vector<ColumnPredicate> preds;
+    int64_t v = 0;
+    for (int64_t p = 0; p < numPreds; p++) {
+      auto idx = schema->ColumnIndex(names[p]);
+      if(idx < 0) {
+        std::string dname(names[p]);
+        std::string fname(filename);
+        std::string msg = "Dataset: " + dname + " does not exist in file: " + fname; 
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+      auto descr = schema->Column(idx);
+      auto logical_type = descr->logical_type();
+      ColumnPredicate pred;
+      pred.col = idx;
+      pred.kind = kinds[p];
+      pred.isUnsigned = logical_type->is_int() &&
+        !std::static_pointer_cast<const parquet::IntLogicalType>(logical_type)->is_signed();
+      auto field = pqFile->schema->GetFieldByName(names[p]);
+      pred.multiplier = field ? nanosPerUnit(storedTimeUnit(descr, field->type())) : 1;
+      for (int64_t k = 0; k < numValues[p]; k++)
+        pred.values.push_back(values[v++]);
+      // decimals are stored unscaled, so their statistics can't be
+      // compared against the values given
+      if(logical_type->is_decimal())
+        continue;
+      withPredicateType(descr->physical_type(), [&](auto dtype) {
+        if constexpr (!std::is_same<decltype(dtype), parquet::ByteArrayType>::value) {
+          for (auto& value : pred.values)
+            pred.numbers.push_back(std::stold(value));
         }
+      });
+      preds.push_back(std::move(pred));
+    }
+
+#if ARROW_VERSION_MAJOR >= 12
+    auto pageIndexReader = pqFile->reader->GetPageIndexReader();
+#endif
+    RowRanges kept;
+    int64_t rgStart = 0;
+    for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+      auto rg_metadata = file_metadata->RowGroup(r);
+      int64_t numRows = rg_metadata->num_rows();
+      RowRanges rgRanges = {{0, numRows}};
+
+      for (auto& pred : preds) {
+        if(rgRanges.empty())
+          break;
+        auto stats = rg_metadata->ColumnChunk(pred.col)->statistics();
+        bool mayMatch = true;
+        withPredicateType(schema->Column(pred.col)->physical_type(), [&](auto dtype) {
+          using DType = decltype(dtype);
+          mayMatch = rowGroupMayMatch<DType>(stats, pred);
+#if ARROW_VERSION_MAJOR >= 12
+          if(!mayMatch || !pageIndexReader)
+            return;
+          auto rgPageIndex = pageIndexReader->RowGroup(r);
+          if(!rgPageIndex)
+            return;
+          auto columnIndex = rgPageIndex->GetColumnIndex(pred.col);
+          auto offsetIndex = rgPageIndex->GetOffsetIndex(pred.col);
+          if(columnIndex && offsetIndex)
+            rgRanges = intersectRowRanges(rgRanges,
+                                          pageRowRanges<DType>(*columnIndex, *offsetIndex, numRows, pred));
+#endif
+        });
+        if(!mayMatch)
+          rgRanges.clear();
       }
+
+      for (auto& range : rgRanges) {
+        int64_t start = rgStart + range.first;
+        int64_t end = rgStart + range.second;
+        if(!kept.empty() && kept.back().second == start)
+          kept.back().second = end;
+        else
+          kept.push_back({start, end});
+      }
+      rgStart += numRows;
     }
-    return 0;
+
+    // returned as (start, count) pairs
+    auto out = (int64_t*)malloc(std::max(kept.size() * 2 * sizeof(int64_t), sizeof(int64_t)));
+    if(!out)
+      throw std::bad_alloc();
+    for (size_t k = 0; k < kept.size(); k++) {
+      out[2*k] = kept[k].first;
+      out[2*k+1] = kept[k].second - kept[k].first;
+    }
+    *ranges = out;
+    return kept.size();
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
     return ARROWERROR;
   }
 }
 
+// Collects the levels and values of a string column and writes them with
+// one WriteBatch per batch rather than one per string. The values are
+// views into the Chapel buffers, so the string bytes aren't copied. Call
+// flush before moving on to another column or row group.
+class ByteArrayBatchWriter {
+public:
+  ByteArrayBatchWriter(parquet::ByteArrayWriter* writer, bool repeated, int64_t batchSize = 8192)
+    : writer(writer), repeated(repeated), batchSize(batchSize) {
+    def_lvl.reserve(batchSize);
+    if(repeated)
+      rep_lvl.reserve(batchSize);
+    values.reserve(batchSize);
+  }
+
+  void value(int16_t def, int16_t rep, const uint8_t* ptr, int64_t len) {
+    values.emplace_back((uint32_t)len, ptr);
+    level(def, rep);
+  }
+
+  void null(int16_t def, int16_t rep) {
+    level(def, rep);
+  }
+
+  void flush() {
+    if(def_lvl.empty())
+      return;
+    writer->WriteBatch(def_lvl.size(), def_lvl.data(),
+                       repeated ? rep_lvl.data() : nullptr, values.data());
+    def_lvl.clear();
+    rep_lvl.clear();
+    values.clear();
+  }
+
+private:
+  void level(int16_t def, int16_t rep) {
+    def_lvl.push_back(def);
+    if(repeated)
+      rep_lvl.push_back(rep);
+    if((int64_t)def_lvl.size() >= batchSize)
+      flush();
+  }
+
+  parquet::ByteArrayWriter* writer;
+  bool repeated;
+  int64_t batchSize;
+  std::vector<int16_t> def_lvl;
+  std::vector<int16_t> rep_lvl;
+  std::vector<parquet::ByteArray> values;
+};
+
+// Definition and repetition levels of a list column for a row group.
+// They are computed for the whole row group at once so that it can be
+// written with a single WriteBatch, and the buffers are kept across row
+// groups so they are only allocated as they grow.
+struct ListLevels {
+  std::vector<int16_t> def_lvl;
+  std::vector<int16_t> rep_lvl;
+
+  // Fill in the levels for segments [segStart, segStart+numSegs) of the
+  // numSegsTotal segments starting at offsets, which hold totalValues
+  // values between them
+  void fill(const int64_t* offsets, int64_t numSegsTotal, int64_t totalValues,
+            int64_t segStart, int64_t numSegs) {
+    auto segLen = [&](int64_t k) {
+      return ((k + 1 < numSegsTotal) ? offsets[k+1] : totalValues) - offsets[k];
+    };
+    int64_t numLevels = 0;
+    for (int64_t k = segStart; k < segStart + numSegs; k++)
+      numLevels += std::max(segLen(k), (int64_t)1);
+    def_lvl.resize(numLevels);
+    rep_lvl.resize(numLevels);
+
+    int64_t l = 0;
+    for (int64_t k = segStart; k < segStart + numSegs; k++) {
+      int64_t len = segLen(k);
+      if (len > 0) {
+        // if the value is first in the segment rep_lvl = 0, otherwise 1
+        // all values defined at the item level (3)
+        std::fill(&def_lvl[l], &def_lvl[l] + len, 3);
+        rep_lvl[l] = 0;
+        std::fill(&rep_lvl[l] + 1, &rep_lvl[l] + len, 1);
+        l += len;
+      } else {
+        // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
+        def_lvl[l] = 1;
+        rep_lvl[l] = 0;
+        l++;
+      }
+    }
+  }
+};
+
+template <typename WriterT, typename T>
+void writeListRowGroup(WriterT* writer, const T* values, const int64_t* offsets,
+                       int64_t numSegsTotal, int64_t totalValues,
+                       int64_t segStart, int64_t numSegs, ListLevels& levels) {
+  levels.fill(offsets, numSegsTotal, totalValues, segStart, numSegs);
+  writer->WriteBatch(levels.def_lvl.size(), levels.def_lvl.data(), levels.rep_lvl.data(),
+                     &values[offsets[segStart]]);
+}
+
+/*
+  Asynchronous file output
+  ------------------------
+  The writers hand each page to the output stream as soon as it is
+  encoded. With a plain FileOutputStream, encoding waits while every
+  write reaches the file system, which is slow on a parallel file
+  system. AsyncOutputStream copies writes into a few large, page-aligned
+  buffers. A background thread writes each full buffer to the file while
+  the writer fills the next one. Flush and Close wait until every buffer
+  has been written, so they behave as they do on the wrapped stream. An
+  error from the background thread is returned by the next call.
+*/
+class AsyncOutputStream : public arrow::io::OutputStream {
+public:
+  AsyncOutputStream(std::shared_ptr<arrow::io::OutputStream> out, int64_t numBuffers, int64_t bufferSize)
+    : out(std::move(out)), bufferSize(bufferSize) {
+    for(int64_t i = 0; i < numBuffers; i++) {
+      void* ptr = nullptr;
+      if(posix_memalign(&ptr, 4096, bufferSize) != 0)
+        throw std::bad_alloc();
+      buffers.emplace_back((uint8_t*)ptr, &free);
+      freeBuffers.push_back(buffers.back().get());
+    }
+    writer = std::thread([this]() { run(); });
+  }
+
+  ~AsyncOutputStream() override {
+    if(!isClosed)
+      (void)Close();
+  }
+
+  using arrow::io::OutputStream::Write;
+
+  arrow::Status Write(const void* data, int64_t nbytes) override {
+    auto src = (const uint8_t*)data;
+    while(nbytes > 0) {
+      if(current == nullptr)
+        acquire();
+      int64_t n = std::min(nbytes, bufferSize - fill);
+      memcpy(current + fill, src, n);
+      fill += n;
+      src += n;
+      nbytes -= n;
+      position += n;
+      if(fill == bufferSize)
+        submit();
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    return error;
+  }
+
+  arrow::Status Flush() override {
+    if(current != nullptr && fill > 0)
+      submit();
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock, [this]() { return pending.empty() && !busy; });
+      ARROW_RETURN_NOT_OK(error);
+    }
+    return out->Flush();
+  }
+
+  arrow::Status Close() override {
+    if(isClosed)
+      return arrow::Status::OK();
+    arrow::Status status = Flush();
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    cv.notify_all();
+    writer.join();
+    isClosed = true;
+    arrow::Status closeStatus = out->Close();
+    return status.ok() ? closeStatus : status;
+  }
+
+  arrow::Result<int64_t> Tell() const override { return position; }
+
+  bool closed() const override { return isClosed; }
+
+private:
+  // waits for a buffer the background thread is done with
+  void acquire() {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this]() { return !freeBuffers.empty(); });
+    current = freeBuffers.back();
+    freeBuffers.pop_back();
+    fill = 0;
+  }
+
+  void submit() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      pending.emplace(current, fill);
+    }
+    current = nullptr;
+    fill = 0;
+    cv.notify_all();
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true) {
+      cv.wait(lock, [this]() { return !pending.empty() || stopping; });
+      if(pending.empty())
+        return;
+      auto [ptr, len] = pending.front();
+      pending.pop();
+      busy = true;
+      bool failed = !error.ok();
+      lock.unlock();
+      // after a failure the remaining buffers are dropped, the error is
+      // what the writer sees
+      arrow::Status status = failed ? arrow::Status::OK() : out->Write(ptr, len);
+      lock.lock();
+      if(!status.ok() && error.ok())
+        error = status;
+      busy = false;
+      freeBuffers.push_back(ptr);
+      cv.notify_all();
+    }
+  }
+
+  std::shared_ptr<arrow::io::OutputStream> out;
+  int64_t bufferSize;
+  std::vector<std::unique_ptr<uint8_t, decltype(&free)>> buffers;
+
+  // only touched by the writing thread
+  uint8_t* current = nullptr;
+  int64_t fill = 0;
+  int64_t position = 0;
+  bool isClosed = false;
+
+  // shared with the background thread, guarded by mtx
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::vector<uint8_t*> freeBuffers;
+  std::queue<std::pair<uint8_t*, int64_t>> pending;
+  bool busy = false;
+  bool stopping = false;
+  arrow::Status error;
+  std::thread writer;
+};
+
+static std::atomic<int64_t> parquetWriteBuffers(2);
+static std::atomic<int64_t> parquetWriteBufferSize(8 * 1024 * 1024);
+
+// Opens a file for one of the writers, buffered asynchronously unless
+// the number of write buffers was set to 0
+static arrow::Result<std::shared_ptr<arrow::io::OutputStream>> openParquetOutput(const std::string& filename) {
+  // drop a cached reader first, truncating a file under a mapping of it
+  // would fault on the next access
+  parquetFileCache.Invalidate(filename);
+  std::shared_ptr<arrow::io::OutputStream> out;
+  ARROW_ASSIGN_OR_RAISE(out, arrow::io::FileOutputStream::Open(filename));
+  if(parquetWriteBuffers.load() <= 0)
+    return out;
+  return std::static_pointer_cast<arrow::io::OutputStream>(
+    std::make_shared<AsyncOutputStream>(out, parquetWriteBuffers.load(),
+                                        std::max(parquetWriteBufferSize.load(), (int64_t)4096)));
+}
+
+/*
+  Column encodings
+  ----------------
+  Compression and encoding can be chosen per column. DEFAULT_ENC keeps
+  the writer's behavior of dictionary encoding with a fallback to plain
+  once the dictionary grows too large. The other encodings turn the
+  dictionary off so the chosen encoding is used for every page.
+  AUTO_ENC looks at an evenly spaced sample of a column's values.
+  - Sorted int64/uint64 columns, like keys, use DELTA_BINARY_PACKED.
+  - float64 columns use BYTE_STREAM_SPLIT, compressed with ZSTD unless a
+    codec was given, since the split bytes are what make them compress.
+  - Strings keep the dictionary only if the sample repeats itself enough.
+*/
+
+static parquet::Compression::type toParquetCompression(int64_t compression) {
+  switch(compression) {
+    case SNAPPY_COMP: return parquet::Compression::SNAPPY;
+    case GZIP_COMP:   return parquet::Compression::GZIP;
+    case BROTLI_COMP: return parquet::Compression::BROTLI;
+    case ZSTD_COMP:   return parquet::Compression::ZSTD;
+    case LZ4_COMP:    return parquet::Compression::LZ4;
+    default:          return parquet::Compression::UNCOMPRESSED;
+  }
+}
+
+static const int64_t autoSampleSize = 1024;
+
+template <typename T>
+static bool sampleIsSorted(const T* values, int64_t numValues) {
+  int64_t step = std::max(numValues / autoSampleSize, (int64_t)1);
+  for(int64_t i = step; i < numValues; i += step) {
+    if(values[i] < values[i - step])
+      return false;
+  }
+  return true;
+}
+
+// strings can't be indexed without their offsets, so sample the first ones
+static bool sampleIsLowCardinality(const uint8_t* values, int64_t numValues) {
+  int64_t count = std::min(numValues, autoSampleSize);
+  std::unordered_set<std::string_view> distinct;
+  int64_t byteIdx = 0;
+  for(int64_t i = 0; i < count; i++) {
+    const char* ptr = reinterpret_cast<const char*>(&values[byteIdx]);
+    int64_t len = strlen(ptr);
+    distinct.emplace(ptr, len);
+    byteIdx += len + 1;
+  }
+  return (int64_t)distinct.size() * 4 <= count;
+}
+
+// Adds the compression and encoding of one column to the writer properties
+static void setColumnEncoding(parquet::WriterProperties::Builder& builder,
+                              const std::shared_ptr<parquet::schema::ColumnPath>& path,
+                              int64_t dtype, const void* values, int64_t numValues,
+                              int64_t encoding, int64_t compression) {
+  if(encoding == AUTO_ENC) {
+    encoding = DEFAULT_ENC;
+    if(dtype == ARROWINT64 && sampleIsSorted((const int64_t*)values, numValues)) {
+      encoding = DELTA_ENC;
+    } else if(dtype == ARROWUINT64 && sampleIsSorted((const uint64_t*)values, numValues)) {
+      encoding = DELTA_ENC;
+    } else if(dtype == ARROWDOUBLE) {
+      encoding = BYTE_STREAM_SPLIT_ENC;
+      if(compression == UNSET_COMP)
+        compression = ZSTD_COMP;
+    } else if(dtype == ARROWSTRING) {
+      encoding = sampleIsLowCardinality((const uint8_t*)values, numValues) ? DICTIONARY_ENC : PLAIN_ENC;
+    }
+  }
+
+  builder.compression(path, toParquetCompression(compression));
+  if(encoding == DEFAULT_ENC) {
+    return;
+  } else if(encoding == DICTIONARY_ENC) {
+    builder.enable_dictionary(path);
+  } else if(encoding == PLAIN_ENC) {
+    builder.disable_dictionary(path);
+    builder.encoding(path, parquet::Encoding::PLAIN);
+  } else if(encoding == DELTA_ENC) {
+    if(dtype != ARROWINT64 && dtype != ARROWUINT64)
+      throw std::invalid_argument("Delta encoding is only supported for int64 and uint64 columns, not " + path->ToDotString());
+    builder.disable_dictionary(path);
+    builder.encoding(path, parquet::Encoding::DELTA_BINARY_PACKED);
+  } else if(encoding == BYTE_STREAM_SPLIT_ENC) {
+    if(dtype != ARROWDOUBLE)
+      throw std::invalid_argument("Byte stream split encoding is only supported for float64 columns, not " + path->ToDotString());
+    builder.disable_dictionary(path);
+    builder.encoding(path, parquet::Encoding::BYTE_STREAM_SPLIT);
+  } else {
+    throw std::invalid_argument("Unrecognized Parquet encoding for column " + path->ToDotString());
+  }
+}
+
+/*
+  Column statistics
+  -----------------
+  Statistics are what let a reader, ours or another engine's, skip row
+  groups and pages that can't match a filter. Each column of a
+  multi-column write can turn off the min/max/null count statistics of
+  its row groups and pages, or add a column and offset index so pages
+  can be pruned without reading their headers. Page indexes need Arrow
+  12, asking for one when building against an older Arrow is an error.
+
+  Columns the caller knows to be sorted are recorded as sorting columns
+  of every row group, which needs Arrow 13. The hint is checked against
+  the data first, since a wrong one would make readers skip real rows.
+*/
+
+static void setColumnStatistics(parquet::WriterProperties::Builder& builder,
+                                const std::shared_ptr<parquet::schema::ColumnPath>& path,
+                                int64_t options) {
+  if(options & STATS_MINMAX)
+    builder.enable_statistics(path);
+  else
+    builder.disable_statistics(path);
+#if ARROW_VERSION_MAJOR >= 12
+  if(options & STATS_PAGE_INDEX)
+    builder.enable_write_page_index(path);
+  else
+    builder.disable_write_page_index(path);
+#else
+  if(options & STATS_PAGE_INDEX)
+    throw std::invalid_argument("Writing a page index for column " + path->ToDotString() +
+                                " needs Arkouda built with Arrow 12 or later");
+#endif
+}
+
+static bool columnIsSorted(int64_t dtype, const void* values, int64_t numValues) {
+  if(dtype == ARROWINT64)
+    return std::is_sorted((const int64_t*)values, (const int64_t*)values + numValues);
+  if(dtype == ARROWUINT64)
+    return std::is_sorted((const uint64_t*)values, (const uint64_t*)values + numValues);
+  if(dtype == ARROWDOUBLE) {
+    // NaN compares false with everything, so is_sorted would let it
+    // through anywhere. Parquet defines no sort order for it either.
+    auto first = (const double*)values, last = first + numValues;
+    return std::none_of(first, last, [](double x) { return std::isnan(x); }) &&
+      std::is_sorted(first, last);
+  }
+  if(dtype == ARROWBOOLEAN)
+    return std::is_sorted((const bool*)values, (const bool*)values + numValues);
+  return false;
+}
+
 // configure the schema for a multicolumn file
 std::shared_ptr<parquet::schema::GroupNode> SetupSchema(void* column_names, void * objTypes, void* datatypes, int64_t colnum) {
   parquet::schema::NodeVector fields;
@@ -978,305 +2464,186 @@ std::shared_ptr<parquet::schema::GroupNode> SetupSchema(void* column_names, void
         fields.push_back(parquet::schema::PrimitiveNode::Make(cname_ptr[i], parquet::Repetition::REQUIRED, parquet::Type::BYTE_ARRAY, parquet::ConvertedType::NONE));
       }
     }
-  }
-  return std::static_pointer_cast<parquet::schema::GroupNode>(
-      parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
-}
+  }
+  return std::static_pointer_cast<parquet::schema::GroupNode>(
+      parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
+}
+
+int cpp_writeMultiColToParquet(const char* filename, void* column_names, 
+                                void** ptr_arr, void** offset_arr, void* objTypes, void* datatypes,
+                                void* segArr_sizes, int64_t colnum, int64_t numelems, int64_t rowGroupSize,
+                                void* compressions, void* encodings, void* statOptions,
+                                void* sortingCols, int64_t numSortingCols, int64_t numThreads,
+                                char** errMsg) {
+  try {
+    auto dtypes_ptr = (int64_t*) datatypes;
+    auto compressions_ptr = (int64_t*) compressions;
+    auto encodings_ptr = (int64_t*) encodings;
+    auto stats_ptr = (int64_t*) statOptions;
+    auto sorting_ptr = (int64_t*) sortingCols;
+    auto objType_ptr = (int64_t*) objTypes;
+    auto saSizes_ptr = (int64_t*) segArr_sizes;
+    for(int64_t i = 0; i < colnum; i++) {
+      int64_t dtype = dtypes_ptr[i];
+      if(dtype != ARROWINT64 && dtype != ARROWUINT64 && dtype != ARROWBOOLEAN &&
+         dtype != ARROWDOUBLE && dtype != ARROWSTRING) {
+        std::string msg = "Unsupported dtype " + std::to_string(dtype) + " for column " +
+          std::string(((char**)column_names)[i]);
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+    }
+#if ARROW_VERSION_MAJOR < 13
+    if(numSortingCols > 0) {
+      *errMsg = strdup("Recording sorting columns needs Arkouda built with Arrow 13 or later");
+      return ARROWERROR;
+    }
+#endif
+    for(int64_t s = 0; s < numSortingCols; s++) {
+      int64_t i = sorting_ptr[s];
+      if(objType_ptr[i] != PDARRAY || !columnIsSorted(dtypes_ptr[i], ptr_arr[i], numelems)) {
+        std::string msg = "Column " + std::string(((char**)column_names)[i]) +
+          " was given as a sorting column, but it is not a sorted numeric column";
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+    }
 
-int cpp_writeMultiColToParquet(const char* filename, void* column_names, 
-                                void** ptr_arr, void** offset_arr, void* objTypes, void* datatypes,
-                                void* segArr_sizes, int64_t colnum, int64_t numelems, int64_t rowGroupSize,
-                                int64_t compression, char** errMsg) {
-  try {
     // initialize the file to write to
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    ARROWRESULT_OK(FileClass::Open(filename), out_file);
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    ARROWRESULT_OK(openParquetOutput(filename), out_file);
 
     // Setup the parquet schema
     std::shared_ptr<parquet::schema::GroupNode> schema = SetupSchema(column_names, objTypes, datatypes, colnum);
 
+    // every column is a single leaf, so leaf i is column i
+    parquet::SchemaDescriptor descr;
+    descr.Init(schema);
     parquet::WriterProperties::Builder builder;
-    // assign the proper compression
-    if(compression == SNAPPY_COMP) {
-      builder.compression(parquet::Compression::SNAPPY);
-    } else if (compression == GZIP_COMP) {
-      builder.compression(parquet::Compression::GZIP);
-    } else if (compression == BROTLI_COMP) {
-      builder.compression(parquet::Compression::BROTLI);
-    } else if (compression == ZSTD_COMP) {
-      builder.compression(parquet::Compression::ZSTD);
-    } else if (compression == LZ4_COMP) {
-      builder.compression(parquet::Compression::LZ4);
+    for(int64_t i = 0; i < colnum; i++) {
+      int64_t numValues = (objType_ptr[i] == SEGARRAY) ? saSizes_ptr[i] : numelems;
+      setColumnEncoding(builder, descr.Column(i)->path(), dtypes_ptr[i], ptr_arr[i], numValues,
+                        encodings_ptr[i], compressions_ptr[i]);
+      setColumnStatistics(builder, descr.Column(i)->path(), stats_ptr[i]);
+    }
+#if ARROW_VERSION_MAJOR >= 13
+    std::vector<parquet::SortingColumn> sorting;
+    for(int64_t s = 0; s < numSortingCols; s++) {
+      parquet::SortingColumn col;
+      col.column_idx = (int32_t)sorting_ptr[s];
+      col.descending = false;
+      col.nulls_first = false;
+      sorting.push_back(col);
     }
+    builder.set_sorting_columns(sorting);
+#endif
     std::shared_ptr<parquet::WriterProperties> props = builder.build();
 
     std::shared_ptr<parquet::ParquetFileWriter> file_writer =
       parquet::ParquetFileWriter::Open(out_file, schema, props);
 
-    std::queue<int64_t> idxQueue_str; // queue used to track string byteIdx 
-    std::queue<int64_t> idxQueue_segarray; // queue used to track index into the offsets
-
-    auto dtypes_ptr = (int64_t*) datatypes;
-    auto objType_ptr = (int64_t*) objTypes;
-    auto saSizes_ptr = (int64_t*) segArr_sizes;
-    int64_t numLeft = numelems; // number of elements remaining to write (rows)
-    int64_t x = 0;  // index to start writing batch from
-    while (numLeft > 0) {
-      // Append a RowGroup with a specific number of rows.
-      parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
-      int64_t batchSize = rowGroupSize;
-      if(numLeft < rowGroupSize)
-        batchSize = numLeft;
-
-      // loop the columns and write the row groups
-      for(int64_t i = 0; i < colnum; i++){
-        int64_t dtype = dtypes_ptr[i];
-        if (dtype == ARROWINT64 || dtype == ARROWUINT64) {
-          auto data_ptr = (int64_t*)ptr_arr[i];
-          parquet::Int64Writer* writer =
-                static_cast<parquet::Int64Writer*>(rg_writer->NextColumn());
-
-          if (objType_ptr[i] == SEGARRAY) {
-            auto offset_ptr = (int64_t*)offset_arr[i];
-            int64_t offIdx = 0; // index into offsets
-
-            if (x > 0){
-              offIdx = idxQueue_segarray.front();
-              idxQueue_segarray.pop();
-            }
-
-            int64_t count = 0;
-            while (count < batchSize) { // ensures rowGroupSize maintained
-              int64_t segSize;
-              if (offIdx == (numelems - 1)) {
-                segSize = saSizes_ptr[i] - offset_ptr[offIdx];
-              }
-              else {
-                segSize = offset_ptr[offIdx+1] - offset_ptr[offIdx];
-              }
-              if (segSize > 0) {
-                int16_t* def_lvl = new int16_t[segSize] { 3 };
-                int16_t* rep_lvl = new int16_t[segSize] { 0 };
-                for (int64_t s = 0; s < segSize; s++){
-                  // if the value is first in the segment rep_lvl = 0, otherwise 1
-                  // all values defined at the item level (3)
-                  rep_lvl[s] = (s == 0) ? 0 : 1;
-                  def_lvl[s] = 3;
-                }
-                int64_t valIdx = offset_ptr[offIdx];
-                writer->WriteBatch(segSize, def_lvl, rep_lvl, &data_ptr[valIdx]);
-                delete[] def_lvl;
-                delete[] rep_lvl;
-              }
-              else {
-                // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-                segSize = 1; // even though segment is length=0, write null to hold the empty segment
-                int16_t def_lvl = 1;
-                int16_t rep_lvl = 0;
-                writer->WriteBatch(segSize, &def_lvl, &rep_lvl, nullptr);
-              }
-              offIdx++;
-              count++;
-            }
-            if (numLeft - count > 0) {
-              idxQueue_segarray.push(offIdx);
-            }
-          } else {
-            writer->WriteBatch(batchSize, nullptr, nullptr, &data_ptr[x]);
-          }
-        } else if(dtype == ARROWBOOLEAN) {
-          auto data_ptr = (bool*)ptr_arr[i];
-            parquet::BoolWriter* writer =
-              static_cast<parquet::BoolWriter*>(rg_writer->NextColumn());
-          if (objType_ptr[i] == SEGARRAY) {
-            auto offset_ptr = (int64_t*)offset_arr[i];
-            int64_t offIdx = 0; // index into offsets
-
-            if (x > 0){
-              offIdx = idxQueue_segarray.front();
-              idxQueue_segarray.pop();
-            }
-
-            int64_t count = 0;
-            while (count < batchSize) { // ensures rowGroupSize maintained
-              int64_t segSize;
-              if (offIdx == numelems - 1) {
-                segSize = saSizes_ptr[i] - offset_ptr[offIdx];
-              }
-              else {
-                segSize = offset_ptr[offIdx+1] - offset_ptr[offIdx];
-              }
-              if (segSize > 0) {
-                int16_t* def_lvl = new int16_t[segSize] { 3 };
-                int16_t* rep_lvl = new int16_t[segSize] { 0 };
-                for (int64_t s = 0; s < segSize; s++){
-                  // if the value is first in the segment rep_lvl = 0, otherwise 1
-                  // all values defined at the item level (3)
-                  rep_lvl[s] = (s == 0) ? 0 : 1;
-                  def_lvl[s] = 3;
-                }
-                int64_t valIdx = offset_ptr[offIdx];
-                writer->WriteBatch(segSize, def_lvl, rep_lvl, &data_ptr[valIdx]);
-                delete[] def_lvl;
-                delete[] rep_lvl;
-              }
-              else {
-                // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-                segSize = 1; // even though segment is length=0, write null to hold the empty segment
-                int16_t def_lvl = 1;
-                int16_t rep_lvl = 0;
-                writer->WriteBatch(segSize, &def_lvl, &rep_lvl, nullptr);
-              }
-              offIdx++;
-              count++;
-            }
-            if (numLeft - count > 0) {
-              idxQueue_segarray.push(offIdx);
-            }
-          } else {
-            writer->WriteBatch(batchSize, nullptr, nullptr, &data_ptr[x]);
-          }
-        } else if(dtype == ARROWDOUBLE) {
-          auto data_ptr = (double*)ptr_arr[i];
-            parquet::DoubleWriter* writer =
-          static_cast<parquet::DoubleWriter*>(rg_writer->NextColumn());
-          if (objType_ptr[i] == SEGARRAY) {
-            auto offset_ptr = (int64_t*)offset_arr[i];
-            int64_t offIdx = 0; // index into offsets
-
-            if (x > 0){
-              offIdx = idxQueue_segarray.front();
-              idxQueue_segarray.pop();
-            }
-
-            int64_t count = 0;
-            while (count < batchSize) { // ensures rowGroupSize maintained
-              int64_t segSize;
-              if (offIdx == numelems - 1) {
-                segSize = saSizes_ptr[i] - offset_ptr[offIdx];
-              }
-              else {
-                segSize = offset_ptr[offIdx+1] - offset_ptr[offIdx];
-              }
-              if (segSize > 0) {
-                int16_t* def_lvl = new int16_t[segSize] { 3 };
-                int16_t* rep_lvl = new int16_t[segSize] { 0 };
-                for (int64_t s = 0; s < segSize; s++){
-                  // if the value is first in the segment rep_lvl = 0, otherwise 1
-                  // all values defined at the item level (3)
-                  rep_lvl[s] = (s == 0) ? 0 : 1;
-                  def_lvl[s] = 3;
-                }
-                int64_t valIdx = offset_ptr[offIdx];
-                writer->WriteBatch(segSize, def_lvl, rep_lvl, &data_ptr[valIdx]);
-                delete[] def_lvl;
-                delete[] rep_lvl;
-              }
-              else {
-                // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-                segSize = 1; // even though segment is length=0, write null to hold the empty segment
-                int16_t def_lvl = 1;
-                int16_t rep_lvl =0;
-                writer->WriteBatch(segSize, &def_lvl, &rep_lvl, nullptr);
-              }
-              offIdx++;
-              count++;
-            }
-            if (numLeft - count > 0) {
-              idxQueue_segarray.push(offIdx);
+    // Each column keeps its own position between row groups, so that the
+    // columns of a row group can be written in any order
+    std::vector<int64_t> strByteIdx(colnum, 0); // byte index into string values
+    std::vector<ListLevels> levels(colnum);     // level buffers of list columns
+
+    auto writeColumn = [&](int64_t i, parquet::ColumnWriter* col_writer, int64_t x, int64_t batchSize) {
+      int64_t dtype = dtypes_ptr[i];
+      if (dtype == ARROWINT64 || dtype == ARROWUINT64) {
+        auto data_ptr = (int64_t*)ptr_arr[i];
+        parquet::Int64Writer* writer = static_cast<parquet::Int64Writer*>(col_writer);
+        if (objType_ptr[i] == SEGARRAY) {
+          // the segments of a row group are its rows, starting at x
+          writeListRowGroup(writer, data_ptr, (int64_t*)offset_arr[i], numelems, saSizes_ptr[i],
+                            x, batchSize, levels[i]);
+        } else {
+          writer->WriteBatch(batchSize, nullptr, nullptr, &data_ptr[x]);
+        }
+      } else if(dtype == ARROWBOOLEAN) {
+        auto data_ptr = (bool*)ptr_arr[i];
+        parquet::BoolWriter* writer = static_cast<parquet::BoolWriter*>(col_writer);
+        if (objType_ptr[i] == SEGARRAY) {
+          writeListRowGroup(writer, data_ptr, (int64_t*)offset_arr[i], numelems, saSizes_ptr[i],
+                            x, batchSize, levels[i]);
+        } else {
+          writer->WriteBatch(batchSize, nullptr, nullptr, &data_ptr[x]);
+        }
+      } else if(dtype == ARROWDOUBLE) {
+        auto data_ptr = (double*)ptr_arr[i];
+        parquet::DoubleWriter* writer = static_cast<parquet::DoubleWriter*>(col_writer);
+        if (objType_ptr[i] == SEGARRAY) {
+          writeListRowGroup(writer, data_ptr, (int64_t*)offset_arr[i], numelems, saSizes_ptr[i],
+                            x, batchSize, levels[i]);
+        } else {
+          writer->WriteBatch(batchSize, nullptr, nullptr, &data_ptr[x]);
+        }
+      } else if(dtype == ARROWSTRING) {
+        auto data_ptr = (uint8_t*)ptr_arr[i];
+        parquet::ByteArrayWriter* ba_writer = static_cast<parquet::ByteArrayWriter*>(col_writer);
+        ByteArrayBatchWriter batch(ba_writer, objType_ptr[i] == SEGARRAY);
+        int64_t byteIdx = strByteIdx[i];
+        if (objType_ptr[i] == SEGARRAY) {
+          auto offset_ptr = (int64_t*)offset_arr[i];
+          for (int64_t offIdx = x; offIdx < x + batchSize; offIdx++) {
+            int64_t segSize;
+            if (offIdx == numelems - 1) {
+              segSize = saSizes_ptr[i] - offset_ptr[offIdx];
             }
-          } else {
-            writer->WriteBatch(batchSize, nullptr, nullptr, &data_ptr[x]);
-          }
-        } else if(dtype == ARROWSTRING) {
-          auto data_ptr = (uint8_t*)ptr_arr[i];
-          parquet::ByteArrayWriter* ba_writer =
-          static_cast<parquet::ByteArrayWriter*>(rg_writer->NextColumn());
-          if (objType_ptr[i] == SEGARRAY) {
-            auto offset_ptr = (int64_t*)offset_arr[i];
-            int64_t byteIdx = 0;
-            int64_t offIdx = 0; // index into offsets
-
-            // identify the starting byte index
-            if (x > 0){
-              byteIdx = idxQueue_str.front();
-              idxQueue_str.pop();
-
-              offIdx = idxQueue_segarray.front();
-              idxQueue_segarray.pop();
+            else {
+              segSize = offset_ptr[offIdx+1] - offset_ptr[offIdx];
             }
-
-            int64_t count = 0;
-            while (count < batchSize) { // ensures rowGroupSize maintained
-              int64_t segSize;
-              if (offIdx == numelems - 1) {
-                segSize = saSizes_ptr[i] - offset_ptr[offIdx];
+            if (segSize > 0) {
+              for (int64_t s=0; s<segSize; s++) {
+                // if the value is first in the segment rep_lvl = 0, otherwise 1
+                // all values defined at the item level (3)
+                const uint8_t* ptr = &data_ptr[byteIdx];
+                int64_t len = strlen(reinterpret_cast<const char*>(ptr));
+                batch.value(3, (s == 0) ? 0 : 1, ptr, len);
+                byteIdx += len + 1; // increment to start of next word
               }
-              else {
-                segSize = offset_ptr[offIdx+1] - offset_ptr[offIdx];
-              }
-              if (segSize > 0) {
-                for (int64_t s=0; s<segSize; s++) {
-                  int16_t def_lvl = 3;
-                  int16_t rep_lvl = (s == 0) ? 0 : 1;
-                  parquet::ByteArray value;
-                  value.ptr = reinterpret_cast<const uint8_t*>(&data_ptr[byteIdx]);
-                  int64_t nextIdx = byteIdx;
-                  while (data_ptr[nextIdx] != 0x00){
-                    nextIdx++;
-                  }
-                  value.len = nextIdx - byteIdx;
-                  ba_writer->WriteBatch(1, &def_lvl, &rep_lvl, &value);
-                  byteIdx = nextIdx + 1; // increment to start of next word
-                }
-              }
-              else {
-                // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-                segSize = 1; // even though segment is length=0, write null to hold the empty segment
-                int16_t* def_lvl = new int16_t[segSize] { 1 };
-                int16_t* rep_lvl = new int16_t[segSize] { 0 };
-                ba_writer->WriteBatch(segSize, def_lvl, rep_lvl, nullptr);
-              }
-              offIdx++;
-              count++;
             }
-            if (numLeft - count > 0) {
-              idxQueue_str.push(byteIdx);
-              idxQueue_segarray.push(offIdx);
+            else {
+              // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
+              // even though segment is length=0, write null to hold the empty segment
+              batch.null(1, 0);
             }
           }
-          else {
-            int64_t count = 0;
-            int64_t byteIdx = 0;
-
-            // identify the starting byte index
-            if (x > 0){
-              byteIdx = idxQueue_str.front();
-              idxQueue_str.pop();
-            }
-            
-            while(count < batchSize) {
-              parquet::ByteArray value;
-              int16_t definition_level = 1;
-              value.ptr = reinterpret_cast<const uint8_t*>(&data_ptr[byteIdx]);
-              int64_t nextIdx = byteIdx;
-              while (data_ptr[nextIdx] != 0x00){
-                nextIdx++;
-              }
-              // subtract 1 since we have the null terminator
-              value.len = nextIdx - byteIdx;
-              ba_writer->WriteBatch(1, &definition_level, nullptr, &value);
-              count++;
-              byteIdx = nextIdx + 1;
-            }
-            if (numLeft - count > 0) {
-              idxQueue_str.push(byteIdx);
-            }
+        }
+        else {
+          for (int64_t count = 0; count < batchSize; count++) {
+            const uint8_t* ptr = &data_ptr[byteIdx];
+            int64_t len = strlen(reinterpret_cast<const char*>(ptr));
+            batch.value(1, 0, ptr, len);
+            byteIdx += len + 1;
           }
-        } else {
-          return ARROWERROR;
         }
+        batch.flush();
+        strByteIdx[i] = byteIdx;
+      }
+    };
+
+    int64_t numLeft = numelems; // number of elements remaining to write (rows)
+    int64_t x = 0;  // index to start writing batch from
+    while (numLeft > 0) {
+      int64_t batchSize = rowGroupSize;
+      if(numLeft < rowGroupSize)
+        batchSize = numLeft;
+
+      if (numThreads <= 1) {
+        // Append a RowGroup with a specific number of rows, and write
+        // the columns one after the other
+        parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
+        for(int64_t i = 0; i < colnum; i++)
+          writeColumn(i, rg_writer->NextColumn(), x, batchSize);
+      } else {
+        // A buffered row group holds all of its columns in memory until
+        // it is closed, so they can be encoded concurrently. The file
+        // layout is the same as writing them in order. The caller keeps
+        // rowGroupSize small enough for this to fit in memory.
+        parquet::RowGroupWriter* rg_writer = file_writer->AppendBufferedRowGroup();
+        parallelFor(colnum, numThreads, [&](int64_t i) {
+          writeColumn(i, rg_writer->column(i), x, batchSize);
+        });
       }
       numLeft -= batchSize;
       x += batchSize;
@@ -1284,6 +2651,8 @@ int cpp_writeMultiColToParquet(const char* filename, void* column_names,
 
     file_writer->Close();
     ARROWSTATUS_OK(out_file->Close());
+
+    parquetFileCache.Invalidate(filename);
     
     return 0;
    } catch (const std::exception& e) {
@@ -1297,9 +2666,8 @@ int cpp_writeColumnToParquet(const char* filename, void* chpl_arr,
                              int64_t rowGroupSize, int64_t dtype, int64_t compression,
                              char** errMsg) {
   try {
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    ARROWRESULT_OK(FileClass::Open(filename), out_file);
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    ARROWRESULT_OK(openParquetOutput(filename), out_file);
 
     parquet::schema::NodeVector fields;
     if(dtype == ARROWINT64)
@@ -1314,18 +2682,7 @@ int cpp_writeColumnToParquet(const char* filename, void* chpl_arr,
       (parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 
     parquet::WriterProperties::Builder builder;
-    // assign the proper compression
-    if(compression == SNAPPY_COMP) {
-      builder.compression(parquet::Compression::SNAPPY);
-    } else if (compression == GZIP_COMP) {
-      builder.compression(parquet::Compression::GZIP);
-    } else if (compression == BROTLI_COMP) {
-      builder.compression(parquet::Compression::BROTLI);
-    } else if (compression == ZSTD_COMP) {
-      builder.compression(parquet::Compression::ZSTD);
-    } else if (compression == LZ4_COMP) {
-      builder.compression(parquet::Compression::LZ4);
-    }
+    builder.compression(toParquetCompression(compression));
     std::shared_ptr<parquet::WriterProperties> props = builder.build();
 
     std::shared_ptr<parquet::ParquetFileWriter> file_writer =
@@ -1336,6 +2693,7 @@ int cpp_writeColumnToParquet(const char* filename, void* chpl_arr,
 
     if (chpl_arr == NULL) {
       // early out to prevent bad memory access
+      parquetFileCache.Invalidate(filename);
       return 0;
     }
 
@@ -1388,6 +2746,8 @@ int cpp_writeColumnToParquet(const char* filename, void* chpl_arr,
     file_writer->Close();
     ARROWSTATUS_OK(out_file->Close());
 
+    parquetFileCache.Invalidate(filename);
+
     return 0;
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
@@ -1400,9 +2760,8 @@ int cpp_writeStrColumnToParquet(const char* filename, void* chpl_arr, void* chpl
                                 int64_t rowGroupSize, int64_t dtype, int64_t compression,
                                 char** errMsg) {
   try {
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    PARQUET_ASSIGN_OR_THROW(out_file, FileClass::Open(filename));
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    PARQUET_ASSIGN_OR_THROW(out_file, openParquetOutput(filename));
 
     parquet::schema::NodeVector fields;
 
@@ -1411,18 +2770,7 @@ int cpp_writeStrColumnToParquet(const char* filename, void* chpl_arr, void* chpl
       (parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 
     parquet::WriterProperties::Builder builder;
-    // assign the proper compression
-    if(compression == SNAPPY_COMP) {
-      builder.compression(parquet::Compression::SNAPPY);
-    } else if (compression == GZIP_COMP) {
-      builder.compression(parquet::Compression::GZIP);
-    } else if (compression == BROTLI_COMP) {
-      builder.compression(parquet::Compression::BROTLI);
-    } else if (compression == ZSTD_COMP) {
-      builder.compression(parquet::Compression::ZSTD);
-    } else if (compression == LZ4_COMP) {
-      builder.compression(parquet::Compression::LZ4);
-    }
+    builder.compression(toParquetCompression(compression));
     std::shared_ptr<parquet::WriterProperties> props = builder.build();
 
     std::shared_ptr<parquet::ParquetFileWriter> file_writer =
@@ -1441,20 +2789,21 @@ int cpp_writeStrColumnToParquet(const char* filename, void* chpl_arr, void* chpl
         parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
         parquet::ByteArrayWriter* ba_writer =
           static_cast<parquet::ByteArrayWriter*>(rg_writer->NextColumn());
+        ByteArrayBatchWriter batch(ba_writer, false);
         int64_t count = 0;
         while(numLeft > 0 && count < rowGroupSize) {
-          parquet::ByteArray value;
-          int16_t definition_level = 1;
-          value.ptr = reinterpret_cast<const uint8_t*>(&chpl_ptr[byteIdx]);
           // subtract 1 since we have the null terminator
-          value.len = offsets[offIdx+1] - offsets[offIdx] - 1;
-          if (value.len == 0)
-            definition_level = 0;
-          ba_writer->WriteBatch(1, &definition_level, nullptr, &value);
+          int64_t len = offsets[offIdx+1] - offsets[offIdx] - 1;
+          // empty strings are written as nulls
+          if (len == 0)
+            batch.null(0, 0);
+          else
+            batch.value(1, 0, &chpl_ptr[byteIdx], len);
           numLeft--;count++;
           offIdx++;
           byteIdx+=offsets[offIdx] - offsets[offIdx-1];
         }
+        batch.flush();
       }
     } else {
       return ARROWERROR;
@@ -1463,6 +2812,8 @@ int cpp_writeStrColumnToParquet(const char* filename, void* chpl_arr, void* chpl
     file_writer->Close();
     ARROWSTATUS_OK(out_file->Close());
 
+    parquetFileCache.Invalidate(filename);
+
     return 0;
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
@@ -1476,9 +2827,8 @@ int cpp_writeStrListColumnToParquet(const char* filename, void* chpl_segs, void*
                                 char** errMsg) {
   try {
     if(dtype == ARROWSTRING) { // check the type here so if it is wrong we don't create a bad file
-      using FileClass = ::arrow::io::FileOutputStream;
-      std::shared_ptr<FileClass> out_file;
-      PARQUET_ASSIGN_OR_THROW(out_file, FileClass::Open(filename));
+      std::shared_ptr<arrow::io::OutputStream> out_file;
+      PARQUET_ASSIGN_OR_THROW(out_file, openParquetOutput(filename));
 
       parquet::schema::NodeVector fields;
 
@@ -1489,18 +2839,7 @@ int cpp_writeStrListColumnToParquet(const char* filename, void* chpl_segs, void*
           (parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 
       parquet::WriterProperties::Builder builder;
-      // assign the proper compression
-      if(compression == SNAPPY_COMP) {
-        builder.compression(parquet::Compression::SNAPPY);
-      } else if (compression == GZIP_COMP) {
-        builder.compression(parquet::Compression::GZIP);
-      } else if (compression == BROTLI_COMP) {
-        builder.compression(parquet::Compression::BROTLI);
-      } else if (compression == ZSTD_COMP) {
-        builder.compression(parquet::Compression::ZSTD);
-      } else if (compression == LZ4_COMP) {
-        builder.compression(parquet::Compression::LZ4);
-      }
+      builder.compression(toParquetCompression(compression));
       std::shared_ptr<parquet::WriterProperties> props = builder.build();
 
       std::shared_ptr<parquet::ParquetFileWriter> file_writer =
@@ -1517,6 +2856,7 @@ int cpp_writeStrListColumnToParquet(const char* filename, void* chpl_segs, void*
         parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
         parquet::ByteArrayWriter* ba_writer =
           static_cast<parquet::ByteArrayWriter*>(rg_writer->NextColumn());
+        ByteArrayBatchWriter batch(ba_writer, true);
         int64_t count = 0;
         while (numLeft > 0 && count < rowGroupSize) { // ensures rowGroupSize maintained
           int64_t segmentLength = segments[segIdx+1] - segments[segIdx];
@@ -1524,29 +2864,26 @@ int cpp_writeStrListColumnToParquet(const char* filename, void* chpl_segs, void*
             auto offsets = (int64_t*)chpl_offsets;
             auto chpl_ptr = (uint8_t*)chpl_arr;
             for (int64_t x = 0; x < segmentLength; x++){
-              int16_t rep_lvl = (x == 0) ? 0 : 1;
-              int16_t def_lvl = 3;
-              parquet::ByteArray value;
-              value.ptr = reinterpret_cast<const uint8_t*>(&chpl_ptr[valIdx]);
-              value.len = offsets[offIdx+1] - offsets[offIdx] - 1;
-              ba_writer->WriteBatch(1, &def_lvl, &rep_lvl, &value);
+              // first value of a segment isn't repeated, all values defined at the item level (3)
+              batch.value(3, (x == 0) ? 0 : 1, &chpl_ptr[valIdx], offsets[offIdx+1] - offsets[offIdx] - 1);
               offIdx++;
               valIdx+=offsets[offIdx] - offsets[offIdx-1];
             }
           } else {
             // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-            segmentLength = 1; // even though segment is length=0, write null to hold the empty segment
-            int16_t def_lvl = 1;
-            int16_t rep_lvl = 0;
-            ba_writer->WriteBatch(segmentLength, &def_lvl, &rep_lvl, nullptr);
+            // even though segment is length=0, write null to hold the empty segment
+            batch.null(1, 0);
           }
           segIdx++;
           numLeft--;count++;
         }
+        batch.flush();
       }
 
       file_writer->Close();
       ARROWSTATUS_OK(out_file->Close());
+
+      parquetFileCache.Invalidate(filename);
       return 0;
     } else {
       return ARROWERROR;
@@ -1562,9 +2899,8 @@ int cpp_writeListColumnToParquet(const char* filename, void* chpl_segs, void* ch
                                 int64_t rowGroupSize, int64_t dtype, int64_t compression,
                                 char** errMsg) {
   try {
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    PARQUET_ASSIGN_OR_THROW(out_file, FileClass::Open(filename));
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    PARQUET_ASSIGN_OR_THROW(out_file, openParquetOutput(filename));
 
     parquet::schema::NodeVector fields;
 
@@ -1593,143 +2929,45 @@ int cpp_writeListColumnToParquet(const char* filename, void* chpl_segs, void* ch
       (parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 
     parquet::WriterProperties::Builder builder;
-    // assign the proper compression
-    if(compression == SNAPPY_COMP) {
-      builder.compression(parquet::Compression::SNAPPY);
-    } else if (compression == GZIP_COMP) {
-      builder.compression(parquet::Compression::GZIP);
-    } else if (compression == BROTLI_COMP) {
-      builder.compression(parquet::Compression::BROTLI);
-    } else if (compression == ZSTD_COMP) {
-      builder.compression(parquet::Compression::ZSTD);
-    } else if (compression == LZ4_COMP) {
-      builder.compression(parquet::Compression::LZ4);
-    }
+    builder.compression(toParquetCompression(compression));
     std::shared_ptr<parquet::WriterProperties> props = builder.build();
 
     std::shared_ptr<parquet::ParquetFileWriter> file_writer =
       parquet::ParquetFileWriter::Open(out_file, schema, props);
 
-    int64_t i = 0;
     int64_t numLeft = numelems;
     auto segments = (int64_t*)chpl_segs;
-    int64_t valIdx = 0; // index into chpl_arr
-    int64_t segIdx = 0; // index into offsets
+    int64_t segIdx = 0; // index into segments
+    ListLevels levels;
 
-    if(dtype == ARROWINT64 || dtype == ARROWUINT64) {     
-      while(numLeft > 0) { // write all local values to the file
-        parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
-        parquet::Int64Writer* writer =
-          static_cast<parquet::Int64Writer*>(rg_writer->NextColumn());
-        int64_t count = 0;
-        while (numLeft > 0 && count < rowGroupSize) { // ensures rowGroupSize maintained
-          int64_t batchSize = segments[segIdx+1] - segments[segIdx];
-          if (batchSize > 0) {
-            auto chpl_ptr = (int64_t*)chpl_arr;
-            int16_t* def_lvl = new int16_t[batchSize] { 3 }; // all values defined at the item level (3)
-            int16_t* rep_lvl = new int16_t[batchSize] { 0 };
-            for (int64_t x = 0; x < batchSize; x++){
-              // if the value is first in the segment rep_lvl = 0, otherwise 1
-              rep_lvl[x] = (x == 0) ? 0 : 1;
-              def_lvl[x] = 3;
-            }
-            writer->WriteBatch(batchSize, def_lvl, rep_lvl, &chpl_ptr[valIdx]);
-            valIdx += batchSize;
-            delete[] def_lvl;
-            delete[] rep_lvl;
-          }
-          else {
-            // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-            batchSize = 1; // even though segment is length=0, write null to hold the empty segment
-            int16_t def_lvl = 1;
-            int16_t rep_lvl = 0;
-            writer->WriteBatch(batchSize, &def_lvl, &rep_lvl, nullptr);
-          }
-          count++;
-          segIdx++;
-          numLeft--;
-        }
-      }
-    }
-    else if (dtype == ARROWBOOLEAN) {
-      while(numLeft > 0) {
-        parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
-        parquet::BoolWriter* writer =
-          static_cast<parquet::BoolWriter*>(rg_writer->NextColumn());
-        int64_t count = 0;
-        while (numLeft > 0 && count < rowGroupSize) {
-          int64_t batchSize = segments[segIdx+1] - segments[segIdx];
-          if (batchSize > 0) {
-            auto chpl_ptr = (bool*)chpl_arr;
-            // if the value is first in the segment rep_lvl = 0, otherwise 1
-            // all values defined at the item level (3)
-            int16_t* def_lvl = new int16_t[batchSize] { 3 };
-            int16_t* rep_lvl = new int16_t[batchSize] { 0 };
-            for (int64_t x = 0; x < batchSize; x++){
-              rep_lvl[x] = (x == 0) ? 0 : 1;
-              def_lvl[x] = 3;
-            }
-            writer->WriteBatch(batchSize, def_lvl, rep_lvl, &chpl_ptr[valIdx]);
-            valIdx += batchSize;
-            delete[] def_lvl;
-            delete[] rep_lvl;
-          }
-          else {
-            // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-            batchSize = 1; // even though segment is length=0, write null to hold the empty segment
-            int16_t def_lvl = 1;
-            int16_t rep_lvl = 0;
-            writer->WriteBatch(batchSize, &def_lvl, &rep_lvl, nullptr);
-          }
-          count++;
-          segIdx++;
-          numLeft--;
-        }
-      }
-    }
-    else if (dtype == ARROWDOUBLE) {      
-      while(numLeft > 0) {
-        parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
-        parquet::DoubleWriter* writer =
-          static_cast<parquet::DoubleWriter*>(rg_writer->NextColumn());
-        int64_t count = 0;
-        while (numLeft > 0 && count < rowGroupSize) {
-          int64_t batchSize = segments[segIdx+1] - segments[segIdx];
-          if (batchSize > 0) {
-            auto chpl_ptr = (double*)chpl_arr;
-            // if the value is first in the segment rep_lvl = 0, otherwise 1
-            // all values defined at the item level (3)
-            int16_t* def_lvl = new int16_t[batchSize] { 3 };
-            int16_t* rep_lvl = new int16_t[batchSize] { 0 };
-            for (int64_t x = 0; x < batchSize; x++){
-              rep_lvl[x] = (x == 0) ? 0 : 1;
-              def_lvl[x] = 3;
-            }
-            writer->WriteBatch(batchSize, def_lvl, rep_lvl, &chpl_ptr[valIdx]);
-            valIdx += batchSize;
-            delete[] def_lvl;
-            delete[] rep_lvl;
-          }
-          else {
-            // empty segment denoted by null value that is not repeated (first of segment) defined at the list level (1)
-            batchSize = 1; // even though segment is length=0, write null to hold the empty segment
-            int16_t def_lvl = 1;
-            int16_t rep_lvl = 0;
-            writer->WriteBatch(batchSize, &def_lvl, &rep_lvl, nullptr);
-          }
-          count++;
-          segIdx++;
-          numLeft--;
-        }
-      }
-    }
-    else {
+    if(dtype != ARROWINT64 && dtype != ARROWUINT64 && dtype != ARROWBOOLEAN && dtype != ARROWDOUBLE)
       return ARROWERROR;
+
+    while(numLeft > 0) { // write all local values to the file
+      parquet::RowGroupWriter* rg_writer = file_writer->AppendRowGroup();
+      int64_t count = std::min(numLeft, rowGroupSize);
+      if(dtype == ARROWINT64 || dtype == ARROWUINT64) {
+        writeListRowGroup(static_cast<parquet::Int64Writer*>(rg_writer->NextColumn()),
+                          (int64_t*)chpl_arr, segments, numelems, segments[numelems],
+                          segIdx, count, levels);
+      } else if (dtype == ARROWBOOLEAN) {
+        writeListRowGroup(static_cast<parquet::BoolWriter*>(rg_writer->NextColumn()),
+                          (bool*)chpl_arr, segments, numelems, segments[numelems],
+                          segIdx, count, levels);
+      } else {
+        writeListRowGroup(static_cast<parquet::DoubleWriter*>(rg_writer->NextColumn()),
+                          (double*)chpl_arr, segments, numelems, segments[numelems],
+                          segIdx, count, levels);
+      }
+      segIdx += count;
+      numLeft -= count;
     }
 
     file_writer->Close();
     ARROWSTATUS_OK(out_file->Close());
 
+    parquetFileCache.Invalidate(filename);
+
     return 0;
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
@@ -1740,9 +2978,8 @@ int cpp_writeListColumnToParquet(const char* filename, void* chpl_segs, void* ch
 int cpp_createEmptyListParquetFile(const char* filename, const char* dsetname, int64_t dtype,
                                int64_t compression, char** errMsg) {
   try {
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    PARQUET_ASSIGN_OR_THROW(out_file, FileClass::Open(filename));
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    PARQUET_ASSIGN_OR_THROW(out_file, openParquetOutput(filename));
 
     parquet::schema::NodeVector fields;
     if (dtype == ARROWINT64) {
@@ -1769,18 +3006,7 @@ int cpp_createEmptyListParquetFile(const char* filename, const char* dsetname, i
       (parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 
     parquet::WriterProperties::Builder builder;
-    // assign the proper compression
-    if(compression == SNAPPY_COMP) {
-      builder.compression(parquet::Compression::SNAPPY);
-    } else if (compression == GZIP_COMP) {
-      builder.compression(parquet::Compression::GZIP);
-    } else if (compression == BROTLI_COMP) {
-      builder.compression(parquet::Compression::BROTLI);
-    } else if (compression == ZSTD_COMP) {
-      builder.compression(parquet::Compression::ZSTD);
-    } else if (compression == LZ4_COMP) {
-      builder.compression(parquet::Compression::LZ4);
-    }
+    builder.compression(toParquetCompression(compression));
     std::shared_ptr<parquet::WriterProperties> props = builder.build();
     std::shared_ptr<parquet::ParquetFileWriter> file_writer =
       parquet::ParquetFileWriter::Open(out_file, schema, props);
@@ -1788,6 +3014,8 @@ int cpp_createEmptyListParquetFile(const char* filename, const char* dsetname, i
     file_writer->Close();
     ARROWSTATUS_OK(out_file->Close());
 
+    parquetFileCache.Invalidate(filename);
+
     return 0;
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
@@ -1798,9 +3026,8 @@ int cpp_createEmptyListParquetFile(const char* filename, const char* dsetname, i
 int cpp_createEmptyParquetFile(const char* filename, const char* dsetname, int64_t dtype,
                                int64_t compression, char** errMsg) {
   try {
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    PARQUET_ASSIGN_OR_THROW(out_file, FileClass::Open(filename));
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    PARQUET_ASSIGN_OR_THROW(out_file, openParquetOutput(filename));
 
     parquet::schema::NodeVector fields;
     if(dtype == ARROWINT64)
@@ -1817,18 +3044,7 @@ int cpp_createEmptyParquetFile(const char* filename, const char* dsetname, int64
       (parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 
     parquet::WriterProperties::Builder builder;
-    // assign the proper compression
-    if(compression == SNAPPY_COMP) {
-      builder.compression(parquet::Compression::SNAPPY);
-    } else if (compression == GZIP_COMP) {
-      builder.compression(parquet::Compression::GZIP);
-    } else if (compression == BROTLI_COMP) {
-      builder.compression(parquet::Compression::BROTLI);
-    } else if (compression == ZSTD_COMP) {
-      builder.compression(parquet::Compression::ZSTD);
-    } else if (compression == LZ4_COMP) {
-      builder.compression(parquet::Compression::LZ4);
-    }
+    builder.compression(toParquetCompression(compression));
     std::shared_ptr<parquet::WriterProperties> props = builder.build();
     std::shared_ptr<parquet::ParquetFileWriter> file_writer =
       parquet::ParquetFileWriter::Open(out_file, schema, props);
@@ -1836,6 +3052,8 @@ int cpp_createEmptyParquetFile(const char* filename, const char* dsetname, int64
     file_writer->Close();
     ARROWSTATUS_OK(out_file->Close());
 
+    parquetFileCache.Invalidate(filename);
+
     return 0;
   } catch (const std::exception& e) {
     *errMsg = strdup(e.what());
@@ -1843,99 +3061,298 @@ int cpp_createEmptyParquetFile(const char* filename, const char* dsetname, int64
   }
 }
 
+/*
+  Appending a column
+  ------------------
+  Appending used to read the whole file into an arrow::Table, add the
+  column and write everything back out, so every append decoded and
+  re-encoded all of the columns already in the file. Instead, the new
+  file is assembled from the old one: each existing column chunk is
+  copied byte-for-byte (a chunk's pages carry no absolute file offsets)
+  and only its footer entry is rebuilt with the shifted offsets. The new
+  column is encoded into the same row group boundaries as the existing
+  ones and becomes the first column in the schema. The result is written
+  to a temporary file that replaces the original once complete, and is
+  removed if anything fails before then.
+
+  The key-value metadata and sorting columns of the file are carried
+  over, with the Arrow schema stored in the metadata extended by the new
+  column. Column and offset indexes can't be carried over, their page
+  offsets would all have to be rewritten, so files with a page index are
+  rejected rather than silently losing it.
+*/
+
+// Creates an empty file with a unique name in the directory of filename,
+// with the same permissions, for a new version of filename to be written
+// to before it replaces it
+static std::string makeTempFile(const std::string& filename) {
+  std::string name = filename + ".XXXXXX";
+  int fd = mkstemp(&name[0]);
+  if(fd < 0)
+    throw std::runtime_error("Unable to create a temporary file next to " + filename + ": " +
+                             std::strerror(errno));
+  struct stat st;
+  if(stat(filename.c_str(), &st) == 0)
+    (void)fchmod(fd, st.st_mode & 07777);
+  close(fd);
+  return name;
+}
+
+// Removes a file when it goes out of scope, unless told to keep it
+struct RemoveFileOnExit {
+  std::string name;
+  bool keep = false;
+  ~RemoveFileOnExit() {
+    if(!keep)
+      std::remove(name.c_str());
+  }
+};
+
+// Copies `length` bytes starting at `offset` in `in` to the end of `out`
+static void copyFileRange(arrow::io::RandomAccessFile* in, arrow::io::OutputStream* out,
+                          int64_t offset, int64_t length) {
+  const int64_t bufferSize = 1 << 23;
+  while(length > 0) {
+    std::shared_ptr<arrow::Buffer> buffer;
+    PARQUET_ASSIGN_OR_THROW(buffer, in->ReadAt(offset, std::min(length, bufferSize)));
+    if(buffer->size() == 0)
+      throw std::runtime_error("Unexpected end of file while copying column chunk");
+    PARQUET_THROW_NOT_OK(out->Write(buffer));
+    offset += buffer->size();
+    length -= buffer->size();
+  }
+}
+
+// Copies an existing column chunk to `out` and records it in `cmd`.
+// Returns the uncompressed size of the chunk, which is what the total
+// byte size of its row group adds up.
+static int64_t copyColumnChunk(arrow::io::RandomAccessFile* in,
+                               arrow::io::OutputStream* out,
+                               const parquet::ColumnChunkMetaData& col,
+                               parquet::ColumnChunkMetaDataBuilder* cmd) {
+  // some writers leave a bogus dictionary offset behind, so only trust
+  // it if it comes before the data pages like it should
+  int64_t start = col.data_page_offset();
+  bool hasDictOffset = col.has_dictionary_page() && col.dictionary_page_offset() > 0 &&
+    col.dictionary_page_offset() < start;
+  if(hasDictOffset)
+    start = col.dictionary_page_offset();
+
+  int64_t newStart;
+  PARQUET_ASSIGN_OR_THROW(newStart, out->Tell());
+  copyFileRange(in, out, start, col.total_compressed_size());
+  int64_t shift = newStart - start;
+
+  std::map<parquet::Encoding::type, int32_t> dictStats;
+  std::map<parquet::Encoding::type, int32_t> dataStats;
+  bool fallback = false;
+  // the footer builder only takes the encodings of a chunk as encoding
+  // stats, so for chunks written without them every listed encoding is
+  // recorded with no page count
+  if(col.encoding_stats().empty()) {
+    for(auto encoding : col.encodings())
+      dataStats[encoding] = 0;
+  }
+  for(auto& stat : col.encoding_stats()) {
+    if(stat.page_type == parquet::PageType::DICTIONARY_PAGE) {
+      dictStats[stat.encoding] += stat.count;
+    } else {
+      dataStats[stat.encoding] += stat.count;
+      if(stat.encoding != parquet::Encoding::PLAIN_DICTIONARY &&
+         stat.encoding != parquet::Encoding::RLE_DICTIONARY)
+        fallback = col.has_dictionary_page();
+    }
+  }
+  if(col.is_stats_set() && col.statistics() != nullptr)
+    cmd->SetStatistics(col.statistics()->Encode());
+  cmd->Finish(col.num_values(), hasDictOffset ? col.dictionary_page_offset() + shift : 0, -1,
+              col.data_page_offset() + shift, col.total_compressed_size(),
+              col.total_uncompressed_size(), col.has_dictionary_page(), fallback,
+              dictStats, dataStats);
+  return col.total_uncompressed_size();
+}
+
 int cpp_appendColumnToParquet(const char* filename, void* chpl_arr,
                               const char* dsetname, int64_t numelems,
                               int64_t dtype, int64_t compression,
                               char** errMsg) {
   try {
-    if (chpl_arr == NULL){
-      // early out to prevent bad memory access
-      return 0;
+    parquet::schema::NodePtr newField;
+    if(dtype == ARROWINT64)
+      newField = parquet::schema::PrimitiveNode::Make(dsetname, parquet::Repetition::REQUIRED, parquet::Type::INT64, parquet::ConvertedType::NONE);
+    else if(dtype == ARROWUINT64)
+      newField = parquet::schema::PrimitiveNode::Make(dsetname, parquet::Repetition::REQUIRED, parquet::Type::INT64, parquet::ConvertedType::UINT_64);
+    else if(dtype == ARROWBOOLEAN)
+      newField = parquet::schema::PrimitiveNode::Make(dsetname, parquet::Repetition::REQUIRED, parquet::Type::BOOLEAN, parquet::ConvertedType::NONE);
+    else if(dtype == ARROWDOUBLE)
+      newField = parquet::schema::PrimitiveNode::Make(dsetname, parquet::Repetition::REQUIRED, parquet::Type::DOUBLE, parquet::ConvertedType::NONE);
+    else if(dtype == ARROWSTRING)
+      newField = parquet::schema::PrimitiveNode::Make(dsetname, parquet::Repetition::OPTIONAL, parquet::Type::BYTE_ARRAY, parquet::ConvertedType::NONE);
+    else {
+      std::string msg = "Unrecognized Parquet dtype"; 
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
     }
+
+    // open the file directly rather than through the cache, the schema
+    // nodes are moved into the new schema below
     std::shared_ptr<arrow::io::ReadableFile> infile;
     ARROWRESULT_OK(arrow::io::ReadableFile::Open(filename, arrow::default_memory_pool()),
                    infile);
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROWSTATUS_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-    // Use threads for case when reading a table with many columns
-    reader->set_use_threads(true);
-
-    std::shared_ptr<arrow::Table> table;
-    std::shared_ptr<arrow::Table>* hold_table = &table;
-    ARROWSTATUS_OK(reader->ReadTable(hold_table));
-
-    arrow::ArrayVector arrays;
-    std::shared_ptr<arrow::Array> values;
-    auto chunk_type = arrow::int64();
-    if(dtype == ARROWINT64) {
-      chunk_type = arrow::int64();
-      arrow::Int64Builder builder;
-      auto chpl_ptr = (int64_t*)chpl_arr;
-      ARROWSTATUS_OK(builder.AppendValues(chpl_ptr, numelems, nullptr))
-      ARROWSTATUS_OK(builder.Finish(&values));
-    } else if(dtype == ARROWUINT64) {
-      chunk_type = arrow::uint64();
-      arrow::UInt64Builder builder;
-      auto chpl_ptr = (uint64_t*)chpl_arr;
-      ARROWSTATUS_OK(builder.AppendValues(chpl_ptr, numelems, nullptr))
-      ARROWSTATUS_OK(builder.Finish(&values));
-    } else if(dtype == ARROWBOOLEAN) {
-      chunk_type = arrow::boolean();
-      arrow::BooleanBuilder builder;
-      auto chpl_ptr = (uint8_t*)chpl_arr;
-      ARROWSTATUS_OK(builder.AppendValues(chpl_ptr, numelems, nullptr))
-      ARROWSTATUS_OK(builder.Finish(&values));
-    } else if(dtype == ARROWSTRING) {
-      chunk_type = arrow::utf8();
-      arrow::StringBuilder builder;
-      auto chpl_ptr = (uint8_t*)chpl_arr;
-      int64_t j = 0;
-      for(int64_t i = 0; i < numelems; i++) {
-        std::string tmp_str = "";
-        while(chpl_ptr[j] != 0x00) {
-          tmp_str += chpl_ptr[j++];
-        }
-        j++;
-        
-        auto const status = builder.Append(tmp_str);
-        if (status.IsCapacityError()) {
-          // Reached current chunk's capacity limit, so start a new one...
-          ARROWSTATUS_OK(builder.Finish(&values));
-          arrays.push_back(values);
-          values.reset();
-          builder.Reset();
-          
-          // ...with this string as its first item.
-          ARROWSTATUS_OK(builder.Append(tmp_str));
-        } else {
-          ARROWSTATUS_OK(status);
-        }
-      }
-      ARROWSTATUS_OK(builder.Finish(&values));
-    } else if(dtype == ARROWDOUBLE) {
-      chunk_type = arrow::float64();
-      arrow::DoubleBuilder builder;
-      auto chpl_ptr = (double*)chpl_arr;
-      ARROWSTATUS_OK(builder.AppendValues(chpl_ptr, numelems, nullptr))
-      ARROWSTATUS_OK(builder.Finish(&values));
-    } else {
-      std::string msg = "Unrecognized Parquet dtype"; 
+    std::unique_ptr<parquet::ParquetFileReader> parquet_reader =
+      parquet::ParquetFileReader::Open(infile);
+    std::shared_ptr<parquet::FileMetaData> file_metadata = parquet_reader->metadata();
+
+    if(file_metadata->num_rows() != numelems) {
+      std::string msg = "Cannot append " + std::to_string(numelems) + " values to " +
+        std::string(filename) + ", which has " + std::to_string(file_metadata->num_rows()) + " rows";
       *errMsg = strdup(msg.c_str());
       return ARROWERROR;
     }
-    arrays.push_back(values);
+#if ARROW_VERSION_MAJOR >= 12
+    std::shared_ptr<parquet::PageIndexReader> pageIndexReader = parquet_reader->GetPageIndexReader();
+    for(int r = 0; pageIndexReader && r < file_metadata->num_row_groups(); r++) {
+      if(pageIndexReader->RowGroup(r)) {
+        std::string msg = "Cannot append to " + std::string(filename) +
+          ", which has a page index that appending would drop; write all of the columns together instead";
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+    }
+#endif
+    const parquet::schema::GroupNode* old_root = file_metadata->schema()->group_node();
+    for(int i = 0; i < old_root->field_count(); i++) {
+      if(old_root->field(i)->name() == dsetname) {
+        std::string msg = "Dataset " + std::string(dsetname) + " already exists in " + std::string(filename);
+        *errMsg = strdup(msg.c_str());
+        return ARROWERROR;
+      }
+    }
+
+    parquet::schema::NodeVector fields;
+    fields.push_back(newField);
+    for(int i = 0; i < old_root->field_count(); i++)
+      fields.push_back(old_root->field(i));
+    parquet::SchemaDescriptor schema;
+    schema.Init(parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
+
+    parquet::WriterProperties::Builder builder;
+    builder.compression(toParquetCompression(compression));
+#if ARROW_VERSION_MAJOR >= 13
+    if(file_metadata->num_row_groups() > 0) {
+      // the new column comes first, so the existing ones shift by one
+      std::vector<parquet::SortingColumn> sorting = file_metadata->RowGroup(0)->sorting_columns();
+      for(auto& col : sorting)
+        col.column_idx++;
+      builder.set_sorting_columns(sorting);
+    }
+#endif
+    std::shared_ptr<parquet::WriterProperties> props = builder.build();
 
-    std::shared_ptr<arrow::ChunkedArray> chunk_sh_ptr;
-    ARROWRESULT_OK(arrow::ChunkedArray::Make({arrays}, chunk_type), chunk_sh_ptr);
+    std::shared_ptr<const arrow::KeyValueMetadata> kv_metadata = file_metadata->key_value_metadata();
+    if(kv_metadata && kv_metadata->Contains("ARROW:schema")) {
+      std::shared_ptr<arrow::Schema> arrow_schema;
+      PARQUET_THROW_NOT_OK(parquet::arrow::FromParquetSchema(file_metadata->schema(),
+                                                             parquet::default_arrow_reader_properties(),
+                                                             kv_metadata, &arrow_schema));
+      std::shared_ptr<arrow::DataType> arrow_type;
+      if(dtype == ARROWINT64)
+        arrow_type = arrow::int64();
+      else if(dtype == ARROWUINT64)
+        arrow_type = arrow::uint64();
+      else if(dtype == ARROWBOOLEAN)
+        arrow_type = arrow::boolean();
+      else if(dtype == ARROWDOUBLE)
+        arrow_type = arrow::float64();
+      else
+        arrow_type = arrow::utf8();
+      PARQUET_ASSIGN_OR_THROW(arrow_schema,
+                              arrow_schema->AddField(0, arrow::field(dsetname, arrow_type, dtype == ARROWSTRING)));
+      std::shared_ptr<arrow::Buffer> serialized;
+      PARQUET_ASSIGN_OR_THROW(serialized, arrow::ipc::SerializeSchema(*arrow_schema));
+      auto updated = kv_metadata->Copy();
+      PARQUET_THROW_NOT_OK(updated->Set("ARROW:schema", arrow::util::base64_encode(serialized->ToString())));
+      kv_metadata = updated;
+    }
+    std::unique_ptr<parquet::FileMetaDataBuilder> metadata_builder =
+      parquet::FileMetaDataBuilder::Make(&schema, props, kv_metadata);
+
+    std::string tmpname = makeTempFile(filename);
+    RemoveFileOnExit tmpGuard{tmpname};
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    ARROWRESULT_OK(openParquetOutput(tmpname), out_file);
+    ARROWSTATUS_OK(out_file->Write("PAR1", 4));
+
+    std::shared_ptr<parquet::schema::ColumnPath> path = schema.Column(0)->path();
+    int64_t rowStart = 0;
+    int64_t byteIdx = 0;
+    for(int r = 0; r < file_metadata->num_row_groups(); r++) {
+      std::unique_ptr<parquet::RowGroupMetaData> old_rg = file_metadata->RowGroup(r);
+      int64_t numRows = old_rg->num_rows();
+      parquet::RowGroupMetaDataBuilder* rg_builder = metadata_builder->AppendRowGroup();
+      rg_builder->set_num_rows(numRows);
+
+      parquet::ColumnChunkMetaDataBuilder* cmd = rg_builder->NextColumnChunk();
+#if ARROW_VERSION_MAJOR >= 13
+      std::shared_ptr<arrow::util::CodecOptions> codecOptions = props->codec_options(path);
+      std::unique_ptr<parquet::PageWriter> pager =
+        parquet::PageWriter::Open(out_file, props->compression(path), cmd, (int16_t)r, 0,
+                                  arrow::default_memory_pool(), false, nullptr, nullptr, false,
+                                  nullptr, nullptr,
+                                  codecOptions ? *codecOptions : arrow::util::CodecOptions());
+#else
+      std::unique_ptr<parquet::PageWriter> pager =
+        parquet::PageWriter::Open(out_file, props->compression(path), props->compression_level(path),
+                                  cmd, (int16_t)r, 0);
+#endif
+      std::shared_ptr<parquet::ColumnWriter> col_writer =
+        parquet::ColumnWriter::Make(cmd, std::move(pager), props.get());
+      if(dtype == ARROWINT64 || dtype == ARROWUINT64) {
+        auto writer = static_cast<parquet::Int64Writer*>(col_writer.get());
+        writer->WriteBatch(numRows, nullptr, nullptr, &((int64_t*)chpl_arr)[rowStart]);
+      } else if(dtype == ARROWBOOLEAN) {
+        auto writer = static_cast<parquet::BoolWriter*>(col_writer.get());
+        writer->WriteBatch(numRows, nullptr, nullptr, &((bool*)chpl_arr)[rowStart]);
+      } else if(dtype == ARROWDOUBLE) {
+        auto writer = static_cast<parquet::DoubleWriter*>(col_writer.get());
+        writer->WriteBatch(numRows, nullptr, nullptr, &((double*)chpl_arr)[rowStart]);
+      } else {
+        auto chpl_ptr = (uint8_t*)chpl_arr;
+        ByteArrayBatchWriter batch(static_cast<parquet::ByteArrayWriter*>(col_writer.get()), false);
+        for(int64_t i = 0; i < numRows; i++) {
+          int64_t len = strlen(reinterpret_cast<const char*>(&chpl_ptr[byteIdx]));
+          // empty strings are written as nulls
+          if (len == 0)
+            batch.null(0, 0);
+          else
+            batch.value(1, 0, &chpl_ptr[byteIdx], len);
+          byteIdx += len + 1;
+        }
+        batch.flush();
+      }
+      // Close returns the bytes written to the column uncompressed, the
+      // same total the file writer gives its row groups
+      int64_t rgBytes = col_writer->Close();
+
+      for(int c = 0; c < old_rg->num_columns(); c++)
+        rgBytes += copyColumnChunk(infile.get(), out_file.get(), *old_rg->ColumnChunk(c),
+                                   rg_builder->NextColumnChunk());
+      rg_builder->Finish(rgBytes, (int16_t)r);
+      rowStart += numRows;
+    }
 
-    auto newField = arrow::field(dsetname, chunk_type);
-    std::shared_ptr<arrow::Table> fin_table;
-    ARROWRESULT_OK(table -> AddColumn(0, newField, chunk_sh_ptr), fin_table);
+    std::unique_ptr<parquet::FileMetaData> new_metadata = metadata_builder->Finish();
+    parquet::WriteFileMetaData(*new_metadata, out_file.get());
+    ARROWSTATUS_OK(out_file->Close());
+    ARROWSTATUS_OK(infile->Close());
 
-    using FileClass = ::arrow::io::FileOutputStream;
-    std::shared_ptr<FileClass> out_file;
-    ARROWRESULT_OK(FileClass::Open(filename), out_file);
-    ARROWSTATUS_OK(parquet::arrow::WriteTable(*fin_table, arrow::default_memory_pool(), out_file, numelems));
+    if(std::rename(tmpname.c_str(), filename) != 0) {
+      std::string msg = "Unable to replace " + std::string(filename) + " with " + tmpname;
+      *errMsg = strdup(msg.c_str());
+      return ARROWERROR;
+    }
+    tmpGuard.keep = true;
+    parquetFileCache.Invalidate(filename);
     
     return 0;
   } catch (const std::exception& e) {
@@ -1950,43 +3367,25 @@ const char* cpp_getVersionInfo(void) {
 
 int cpp_getDatasetNames(const char* filename, char** dsetResult, bool readNested, char** errMsg) {
   try {
-    std::shared_ptr<arrow::io::ReadableFile> infile;
-    ARROWRESULT_OK(arrow::io::ReadableFile::Open(filename, arrow::default_memory_pool()),
-                   infile);
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    ARROWSTATUS_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-
-    std::shared_ptr<arrow::Schema> sc;
-    std::shared_ptr<arrow::Schema>* out = &sc;
-    ARROWSTATUS_OK(reader->GetSchema(out));
+    std::shared_ptr<CachedParquetFile> pqFile;
+    ARROWRESULT_OK(openCachedParquetFile(filename), pqFile);
+    std::shared_ptr<arrow::Schema> sc = pqFile->schema;
 
     std::string fields = "";
     bool first = true;
 
     for(int i = 0; i < sc->num_fields(); i++) {
-      // only add fields of supported types
-      if(sc->field(i)->type()->id() == arrow::Type::INT64 ||
-         sc->field(i)->type()->id() == arrow::Type::INT32 ||
-         sc->field(i)->type()->id() == arrow::Type::INT16 ||
-         sc->field(i)->type()->id() == arrow::Type::UINT64 ||
-         sc->field(i)->type()->id() == arrow::Type::UINT32 ||
-         sc->field(i)->type()->id() == arrow::Type::UINT16 ||
-         sc->field(i)->type()->id() == arrow::Type::TIMESTAMP ||
-         sc->field(i)->type()->id() == arrow::Type::BOOL ||
-         sc->field(i)->type()->id() == arrow::Type::STRING ||
-         sc->field(i)->type()->id() == arrow::Type::BINARY ||
-         sc->field(i)->type()->id() == arrow::Type::FLOAT ||
-         sc->field(i)->type()->id() == arrow::Type::DOUBLE ||
-         (sc->field(i)->type()->id() == arrow::Type::LIST && readNested) ||
-         sc->field(i)->type()->id() == arrow::Type::DECIMAL
-         ) {
+      // only add fields of supported types, lists only when nested
+      // datasets are requested
+      int ty = getTypeCode(sc->field(i)->type());
+      if(ty == ARROWLIST && !readNested) {
+        continue;
+      } else if(ty != ARROWERROR) {
         if(!first)
           fields += ("," + sc->field(i)->name());
         else
           fields += (sc->field(i)->name());
         first = false;
-      } else if (sc->field(i)->type()->id() == arrow::Type::LIST && !readNested) {
-        continue;
       } else {
         std::string fname(filename);
         std::string dname(sc->field(i)->ToString());
@@ -2008,6 +3407,39 @@ void cpp_free_string(void* ptr) {
   free(ptr);
 }
 
+void cpp_setParquetFileCacheCapacity(int64_t capacity) {
+  parquetFileCache.SetCapacity(capacity);
+}
+
+void cpp_setParquetMemoryMap(bool enabled) {
+  parquetMemoryMap = enabled;
+  // files already open keep the way they were opened until reopened
+  parquetFileCache.Clear();
+}
+
+void cpp_setParquetPreBuffer(bool enabled, int64_t holeSizeLimit, int64_t rangeSizeLimit,
+                             int64_t bufferedStreamSize) {
+  parquetPreBuffer = enabled;
+  parquetHoleSizeLimit = holeSizeLimit;
+  parquetRangeSizeLimit = rangeSizeLimit;
+  parquetBufferedStreamSize = bufferedStreamSize;
+  // cached readers were opened with the old stream settings
+  parquetFileCache.Clear();
+}
+
+void cpp_setParquetWriteBuffers(int64_t numBuffers, int64_t bufferSize) {
+  parquetWriteBuffers = numBuffers;
+  parquetWriteBufferSize = bufferSize;
+}
+
+void cpp_invalidateParquetFileCache(const char* filename) {
+  parquetFileCache.Invalidate(filename);
+}
+
+void cpp_clearParquetFileCache(void) {
+  parquetFileCache.Clear();
+}
+
 /*
  C functions
  -----------
@@ -2027,8 +3459,41 @@ extern "C" {
     return cpp_readListColumnByName(filename, chpl_arr, colname, numElems, startIdx, batchSize, errMsg);
   }
 
-  int c_readColumnByName(const char* filename, void* chpl_arr, const char* colname, int64_t numElems, int64_t startIdx, int64_t batchSize, int64_t byteLength, char** errMsg) {
-    return cpp_readColumnByName(filename, chpl_arr, colname, numElems, startIdx, batchSize, byteLength, errMsg);
+  int c_readColumnByName(const char* filename, void* chpl_arr, const char* colname, int64_t numElems, int64_t startIdx, int64_t batchSize, int64_t byteLength, int64_t numThreads, char** errMsg) {
+    return cpp_readColumnByName(filename, chpl_arr, colname, numElems, startIdx, batchSize, byteLength, numThreads, errMsg);
+  }
+
+  int64_t c_readStrColumnByName(const char* filename, const char* colname, void* chpl_lengths,
+                                void* chpl_validity, void** values, int64_t numElems,
+                                int64_t startIdx, int64_t batchSize, char** errMsg) {
+    return cpp_readStrColumnByName(filename, colname, chpl_lengths, chpl_validity, values,
+                                   numElems, startIdx, batchSize, errMsg);
+  }
+
+  int c_isDictionaryEncoded(const char* filename, const char* colname, char** errMsg) {
+    return cpp_isDictionaryEncoded(filename, colname, errMsg);
+  }
+
+  int64_t c_readDictColumnByName(const char* filename, void* chpl_codes, const char* colname,
+                                 int64_t numElems, int64_t startIdx, int64_t batchSize,
+                                 void** dictValues, int64_t* dictNumBytes, char** errMsg) {
+    return cpp_readDictColumnByName(filename, chpl_codes, colname, numElems, startIdx, batchSize,
+                                    dictValues, dictNumBytes, errMsg);
+  }
+
+  int c_readColumnsByName(const char* filename, void** chpl_arrs, void** chpl_validities,
+                          void* column_names, void* byteLengths, int64_t numCols,
+                          int64_t numElems, int64_t startIdx, int64_t batchSize,
+                          int64_t numThreads, char** errMsg) {
+    return cpp_readColumnsByName(filename, chpl_arrs, chpl_validities, column_names, byteLengths,
+                                 numCols, numElems, startIdx, batchSize, numThreads, errMsg);
+  }
+
+  int64_t c_getFilteredRowRanges(const char* filename, void* column_names, void* pred_kinds,
+                                 void* pred_num_values, void* pred_values, int64_t numPreds,
+                                 void** ranges, char** errMsg) {
+    return cpp_getFilteredRowRanges(filename, column_names, pred_kinds, pred_num_values,
+                                    pred_values, numPreds, ranges, errMsg);
   }
 
   int c_getType(const char* filename, const char* colname, char** errMsg) {
@@ -2039,6 +3504,13 @@ extern "C" {
     return cpp_getListType(filename, colname, errMsg);
   }
 
+  int64_t c_getFileInfo(const char* filename, void* column_names, int64_t numCols,
+                        void* colInfo, void** rowGroupRows, int64_t* numRowGroups,
+                        char** errMsg) {
+    return cpp_getFileInfo(filename, column_names, numCols, colInfo, rowGroupRows,
+                           numRowGroups, errMsg);
+  }
+
   int c_writeColumnToParquet(const char* filename, void* chpl_arr,
                              int64_t colnum, const char* dsetname, int64_t numelems,
                              int64_t rowGroupSize, int64_t dtype, int64_t compression,
@@ -2119,11 +3591,41 @@ extern "C" {
   int c_writeMultiColToParquet(const char* filename, void* column_names, 
                                 void** ptr_arr, void** offset_arr, void* objTypes, void* datatypes,
                                 void* segArr_sizes, int64_t colnum, int64_t numelems, int64_t rowGroupSize,
-                                int64_t compression, char** errMsg){
-    return cpp_writeMultiColToParquet(filename, column_names, ptr_arr, offset_arr, objTypes, datatypes, segArr_sizes, colnum, numelems, rowGroupSize, compression, errMsg);
+                                void* compressions, void* encodings, void* statOptions,
+                                void* sortingCols, int64_t numSortingCols, int64_t numThreads, char** errMsg){
+    return cpp_writeMultiColToParquet(filename, column_names, ptr_arr, offset_arr, objTypes, datatypes, segArr_sizes, colnum, numelems, rowGroupSize, compressions, encodings, statOptions, sortingCols, numSortingCols, numThreads, errMsg);
   }
 
   int c_getPrecision(const char* filename, const char* colname, char** errMsg) {
     return cpp_getPrecision(filename, colname, errMsg);
   }
+
+  int c_getScale(const char* filename, const char* colname, char** errMsg) {
+    return cpp_getScale(filename, colname, errMsg);
+  }
+
+  void c_setParquetFileCacheCapacity(int64_t capacity) {
+    cpp_setParquetFileCacheCapacity(capacity);
+  }
+
+  void c_setParquetMemoryMap(bool enabled) {
+    cpp_setParquetMemoryMap(enabled);
+  }
+
+  void c_setParquetPreBuffer(bool enabled, int64_t holeSizeLimit, int64_t rangeSizeLimit,
+                             int64_t bufferedStreamSize) {
+    cpp_setParquetPreBuffer(enabled, holeSizeLimit, rangeSizeLimit, bufferedStreamSize);
+  }
+
+  void c_setParquetWriteBuffers(int64_t numBuffers, int64_t bufferSize) {
+    cpp_setParquetWriteBuffers(numBuffers, bufferSize);
+  }
+
+  void c_invalidateParquetFileCache(const char* filename) {
+    cpp_invalidateParquetFileCache(filename);
+  }
+
+  void c_clearParquetFileCache(void) {
+    cpp_clearParquetFileCache();
+  }
 }
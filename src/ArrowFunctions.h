@@ -6,13 +6,47 @@
 #include <iostream>
 #include <arrow/api.h>
 #include <arrow/io/api.h>
+#include <arrow/io/caching.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/util/base64.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
 #include <parquet/column_reader.h>
 #include <parquet/api/writer.h>
 #include <parquet/schema.h>
+#include <parquet/arrow/schema.h>
+#include <parquet/statistics.h>
+#if ARROW_VERSION_MAJOR >= 12
+#include <parquet/page_index.h>
+#endif
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/vfs.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <queue>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 extern "C" {
 #endif
 
@@ -23,24 +57,70 @@ extern "C" {
 #define ARROWBOOLEAN 4
 #define ARROWFLOAT 5
 #define ARROWDOUBLE 7
-#define ARROWTIMESTAMP ARROWINT64
 #define ARROWSTRING 6
 #define ARROWLIST 8
 #define ARROWDECIMAL 9
+#define ARROWTIMESTAMP 10
+#define ARROWDATE 11
+#define ARROWDURATION 12
 #define ARROWERROR -1
 
+// The unit of a time column, timestamps, dates and durations are all
+// read as nanoseconds
+#define TIMEUNIT_SECOND 0
+#define TIMEUNIT_MILLI 1
+#define TIMEUNIT_MICRO 2
+#define TIMEUNIT_NANO 3
+#define TIMEUNIT_DAY 4
+
+// Decimals up to this precision are read as int64, wider ones as the
+// 64-bit limbs of a bigint, two for up to 38 digits and four beyond that
+#define DECIMAL_INT64_PRECISION 18
+
 #define ARRAYVIEW 0 // not currently used, but included for continuity with Chapel
 #define PDARRAY 1
 #define STRINGS 2
 #define SEGARRAY 3
 
 // compression mappings
+#define UNSET_COMP -1 // not given, uncompressed unless AUTO_ENC picks a codec
 #define SNAPPY_COMP 1
 #define GZIP_COMP 2
 #define BROTLI_COMP 3
 #define ZSTD_COMP 4
 #define LZ4_COMP 5
 
+// encoding mappings
+#define DEFAULT_ENC 0           // dictionary, falling back to plain
+#define PLAIN_ENC 1
+#define DICTIONARY_ENC 2
+#define DELTA_ENC 3             // DELTA_BINARY_PACKED, int64 and uint64 only
+#define BYTE_STREAM_SPLIT_ENC 4 // float64 only
+#define AUTO_ENC 5              // picked from a sample of the column
+
+// statistics options of a written column, or'd together
+#define STATS_MINMAX 1     // min/max/null count of row groups and pages
+#define STATS_PAGE_INDEX 2 // column and offset indexes, needs Arrow 12
+
+// predicate kinds for pruning row groups on a read
+#define PREDRANGE 0 // low <= value <= high
+#define PREDMIN 1   // low <= value
+#define PREDMAX 2   // value <= high
+#define PREDIN 3    // value is one of a set of values
+
+  // What a read needs to know about a column, from the footer of a file
+  typedef struct {
+    int32_t typeCode;         // ARROW* type of the column
+    int32_t listTypeCode;     // ARROW* type of the elements of a list, ARROWERROR otherwise
+    int32_t precision;        // precision of a decimal, 0 otherwise
+    int32_t scale;            // scale of a decimal, 0 otherwise
+    int32_t timeUnit;         // TIMEUNIT_* the values of a time column are stored in, -1 otherwise
+    int32_t hasTimeZone;      // whether a timestamp is UTC normalized, with a time zone
+    int32_t byteLength;       // bytes per value of a decimal, -1 otherwise
+    int64_t nullCount;        // nulls in the column, -1 if not in the statistics
+    int64_t uncompressedSize; // uncompressed bytes of the column chunks
+  } ColumnInfo;
+
   // Each C++ function contains the actual implementation of the
   // functionality, and there is a corresponding C function that
   // Chapel can call into through C interoperability, since there
@@ -50,10 +130,45 @@ extern "C" {
 
   int c_readColumnByName(const char* filename, void* chpl_arr,
                          const char* colname, int64_t numElems, int64_t startIdx,
-                         int64_t batchSize, int64_t byteLength, char** errMsg);
+                         int64_t batchSize, int64_t byteLength, int64_t numThreads,
+                         char** errMsg);
   int cpp_readColumnByName(const char* filename, void* chpl_arr,
                            const char* colname, int64_t numElems, int64_t startIdx,
-                           int64_t batchSize, int64_t byteLength, char** errMsg);
+                           int64_t batchSize, int64_t byteLength, int64_t numThreads,
+                           char** errMsg);
+
+  int c_readColumnsByName(const char* filename, void** chpl_arrs, void** chpl_validities,
+                          void* column_names, void* byteLengths, int64_t numCols,
+                          int64_t numElems, int64_t startIdx, int64_t batchSize,
+                          int64_t numThreads, char** errMsg);
+  int cpp_readColumnsByName(const char* filename, void** chpl_arrs, void** chpl_validities,
+                            void* column_names, void* byteLengths, int64_t numCols,
+                            int64_t numElems, int64_t startIdx, int64_t batchSize,
+                            int64_t numThreads, char** errMsg);
+
+  int64_t c_readStrColumnByName(const char* filename, const char* colname, void* chpl_lengths,
+                                void* chpl_validity, void** values, int64_t numElems,
+                                int64_t startIdx, int64_t batchSize, char** errMsg);
+  int64_t cpp_readStrColumnByName(const char* filename, const char* colname, void* chpl_lengths,
+                                  void* chpl_validity, void** values, int64_t numElems,
+                                  int64_t startIdx, int64_t batchSize, char** errMsg);
+
+  int64_t c_getFilteredRowRanges(const char* filename, void* column_names, void* pred_kinds,
+                                 void* pred_num_values, void* pred_values, int64_t numPreds,
+                                 void** ranges, char** errMsg);
+  int64_t cpp_getFilteredRowRanges(const char* filename, void* column_names, void* pred_kinds,
+                                   void* pred_num_values, void* pred_values, int64_t numPreds,
+                                   void** ranges, char** errMsg);
+
+  int c_isDictionaryEncoded(const char* filename, const char* colname, char** errMsg);
+  int cpp_isDictionaryEncoded(const char* filename, const char* colname, char** errMsg);
+
+  int64_t c_readDictColumnByName(const char* filename, void* chpl_codes, const char* colname,
+                                 int64_t numElems, int64_t startIdx, int64_t batchSize,
+                                 void** dictValues, int64_t* dictNumBytes, char** errMsg);
+  int64_t cpp_readDictColumnByName(const char* filename, void* chpl_codes, const char* colname,
+                                   int64_t numElems, int64_t startIdx, int64_t batchSize,
+                                   void** dictValues, int64_t* dictNumBytes, char** errMsg);
 
   int c_readListColumnByName(const char* filename, void* chpl_arr, 
                             const char* colname, int64_t numElems, 
@@ -81,6 +196,13 @@ extern "C" {
   int c_getListType(const char* filename, const char* colname, char** errMsg);
   int cpp_getListType(const char* filename, const char* colname, char** errMsg);
 
+  int64_t c_getFileInfo(const char* filename, void* column_names, int64_t numCols,
+                        void* colInfo, void** rowGroupRows, int64_t* numRowGroups,
+                        char** errMsg);
+  int64_t cpp_getFileInfo(const char* filename, void* column_names, int64_t numCols,
+                          void* colInfo, void** rowGroupRows, int64_t* numRowGroups,
+                          char** errMsg);
+
   int cpp_writeColumnToParquet(const char* filename, void* chpl_arr,
                                int64_t colnum, const char* dsetname, int64_t numelems,
                                int64_t rowGroupSize, int64_t dtype, int64_t compression,
@@ -138,15 +260,40 @@ extern "C" {
   int c_writeMultiColToParquet(const char* filename, void* column_names, 
                                 void** ptr_arr, void** offset_arr, void* objTypes, void* datatypes,
                                 void* segArr_sizes, int64_t colnum, int64_t numelems, int64_t rowGroupSize,
-                                int64_t compression, char** errMsg);
+                                void* compressions, void* encodings, void* statOptions,
+                                void* sortingCols, int64_t numSortingCols, int64_t numThreads, char** errMsg);
 
   int cpp_writeMultiColToParquet(const char* filename, void* column_names, 
                                   void** ptr_arr, void** offset_arr, void* objTypes, void* datatypes,
                                   void* segArr_sizes, int64_t colnum, int64_t numelems, int64_t rowGroupSize,
-                                  int64_t compression, char** errMsg);
+                                  void* compressions, void* encodings, void* statOptions,
+                                  void* sortingCols, int64_t numSortingCols, int64_t numThreads, char** errMsg);
+
+  void c_setParquetFileCacheCapacity(int64_t capacity);
+  void cpp_setParquetFileCacheCapacity(int64_t capacity);
+
+  void c_setParquetMemoryMap(bool enabled);
+  void cpp_setParquetMemoryMap(bool enabled);
+
+  void c_setParquetPreBuffer(bool enabled, int64_t holeSizeLimit, int64_t rangeSizeLimit,
+                             int64_t bufferedStreamSize);
+  void cpp_setParquetPreBuffer(bool enabled, int64_t holeSizeLimit, int64_t rangeSizeLimit,
+                               int64_t bufferedStreamSize);
+
+  void c_setParquetWriteBuffers(int64_t numBuffers, int64_t bufferSize);
+  void cpp_setParquetWriteBuffers(int64_t numBuffers, int64_t bufferSize);
+
+  void c_invalidateParquetFileCache(const char* filename);
+  void cpp_invalidateParquetFileCache(const char* filename);
+
+  void c_clearParquetFileCache(void);
+  void cpp_clearParquetFileCache(void);
 
   int c_getPrecision(const char* filename, const char* colname, char** errMsg);
   int cpp_getPrecision(const char* filename, const char* colname, char** errMsg);
+
+  int c_getScale(const char* filename, const char* colname, char** errMsg);
+  int cpp_getScale(const char* filename, const char* colname, char** errMsg);
     
   const char* c_getVersionInfo(void);
   const char* cpp_getVersionInfo(void);
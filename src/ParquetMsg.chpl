@@ -16,12 +16,17 @@ module ParquetMsg {
   use CTypes;
 
   use SegmentedString;
+  use Unique;
+  use BigInteger;
 
   use Map;
   use ArkoudaCTypesCompat;
   use ArkoudaIOCompat;
 
+  // UNSET is a column without a compression given, which is written
+  // uncompressed unless its encoding picks a codec, see ArrowFunctions.h
   enum CompressionType {
+    UNSET=-1,
     NONE=0,
     SNAPPY=1,
     GZIP=2,
@@ -30,6 +35,16 @@ module ParquetMsg {
     LZ4=5
   };
 
+  // encodings of the columns of a multi-column write, see ArrowFunctions.h
+  enum EncodingType {
+    DEFAULT=0,
+    PLAIN=1,
+    DICTIONARY=2,
+    DELTA=3,
+    BYTE_STREAM_SPLIT=4,
+    AUTO=5
+  };
+
 
   // Use reflection for error information
   use Reflection;
@@ -45,6 +60,37 @@ module ParquetMsg {
   private config const ROWGROUPS = 512*1024*1024 / numBytes(int); // 512 mb of int64
   // Undocumented for now, just for internal experiments
   private config const batchSize = getEnvInt("ARKOUDA_SERVER_PARQUET_BATCH_SIZE", 8192);
+  // Number of Parquet files per locale whose opened reader and parsed
+  // footer are kept between calls into the Arrow functions, -1 sizes it
+  // from the open file limit
+  private config const fileCacheSize = getEnvInt("ARKOUDA_SERVER_PARQUET_FILE_CACHE_SIZE", -1);
+  // Memory map Parquet files on local file systems instead of reading
+  // them, for files that are read repeatedly. Network file systems are
+  // always read normally.
+  private config const memoryMap = getEnvInt("ARKOUDA_SERVER_PARQUET_MEMORY_MAP", 0) != 0;
+  // Number of threads used to decode the row groups of a single file
+  // concurrently. Useful when a locale reads a few large files and the
+  // forall over files alone does not keep its cores busy.
+  private config const readThreads = getEnvInt("ARKOUDA_SERVER_PARQUET_READ_THREADS", 1);
+  // Fetch all of the column chunks a read needs up front, coalesced
+  // into a few large reads. Gaps up to the hole size limit are read
+  // through and no read is larger than the range size limit. A buffered
+  // stream size above 0 reads column chunks through a stream that size.
+  private config const preBuffer = getEnvInt("ARKOUDA_SERVER_PARQUET_PRE_BUFFER", 0) != 0;
+  private config const holeSizeLimit = getEnvInt("ARKOUDA_SERVER_PARQUET_HOLE_SIZE_LIMIT", 8*1024);
+  private config const rangeSizeLimit = getEnvInt("ARKOUDA_SERVER_PARQUET_RANGE_SIZE_LIMIT", 32*1024*1024);
+  private config const bufferedStreamSize = getEnvInt("ARKOUDA_SERVER_PARQUET_BUFFERED_STREAM_SIZE", 0);
+  // Number of threads used to encode the columns of a row group
+  // concurrently when writing several columns to a file
+  private config const writeThreads = getEnvInt("ARKOUDA_SERVER_PARQUET_WRITE_THREADS", 1);
+  // A row group encoded concurrently is held in memory until all of its
+  // columns are done, so it is cut to about this many bytes of data
+  private config const writeRowGroupBytes = getEnvInt("ARKOUDA_SERVER_PARQUET_WRITE_ROW_GROUP_BYTES", 128*1024*1024);
+  // Number and size in bytes of the buffers a background thread writes
+  // to files from while the writers keep encoding, 0 buffers writes
+  // synchronously
+  private config const writeBuffers = getEnvInt("ARKOUDA_SERVER_PARQUET_WRITE_BUFFERS", 2);
+  private config const writeBufferSize = getEnvInt("ARKOUDA_SERVER_PARQUET_WRITE_BUFFER_SIZE", 8*1024*1024);
 
   extern var ARROWINT64: c_int;
   extern var ARROWINT32: c_int;
@@ -57,11 +103,31 @@ module ParquetMsg {
   extern var ARROWDOUBLE: c_int;
   extern var ARROWERROR: c_int;
   extern var ARROWDECIMAL: c_int;
+  extern var ARROWTIMESTAMP: c_int;
+  extern var ARROWDATE: c_int;
+  extern var ARROWDURATION: c_int;
+  extern var PREDRANGE: c_int;
+  extern var PREDMIN: c_int;
+  extern var PREDMAX: c_int;
+  extern var PREDIN: c_int;
+  extern var DECIMAL_INT64_PRECISION: c_int;
 
   enum ArrowTypes { int64, int32, uint64, uint32,
                     stringArr, timestamp, boolean,
                     double, float, list, decimal,
-                    notimplemented };
+                    date, duration, notimplemented };
+
+  extern record ColumnInfo {
+    var typeCode: int(32);
+    var listTypeCode: int(32);
+    var precision: int(32);
+    var scale: int(32);
+    var timeUnit: int(32);
+    var hasTimeZone: int(32);
+    var byteLength: int(32);
+    var nullCount: int;
+    var uncompressedSize: int;
+  }
 
   record parquetErrorMsg {
     var errMsg: c_ptr(uint(8));
@@ -109,6 +175,34 @@ module ParquetMsg {
     return ret;
   }
   
+  proc setFileCacheCapacity(capacity: int) {
+    extern proc c_setParquetFileCacheCapacity(capacity);
+    coforall loc in Locales do on loc {
+      c_setParquetFileCacheCapacity(capacity);
+    }
+  }
+
+  proc setMemoryMap(enabled: bool) {
+    extern proc c_setParquetMemoryMap(enabled: bool);
+    coforall loc in Locales do on loc {
+      c_setParquetMemoryMap(enabled);
+    }
+  }
+
+  proc setPreBuffer(enabled: bool, holeSize: int, rangeSize: int, streamSize: int) {
+    extern proc c_setParquetPreBuffer(enabled: bool, holeSize, rangeSize, streamSize);
+    coforall loc in Locales do on loc {
+      c_setParquetPreBuffer(enabled, holeSize, rangeSize, streamSize);
+    }
+  }
+
+  proc setWriteBuffers(numBuffers: int, bufferSize: int) {
+    extern proc c_setParquetWriteBuffers(numBuffers, bufferSize);
+    coforall loc in Locales do on loc {
+      c_setParquetWriteBuffers(numBuffers, bufferSize);
+    }
+  }
+
   proc getSubdomains(lengths: [?FD] int) {
     var subdoms: [FD] domain(1);
     var offset = 0;
@@ -119,61 +213,411 @@ module ParquetMsg {
     return (subdoms, (+ reduce lengths));
   }
 
-  proc readFilesByName(ref A: [] ?t, filenames: [] string, sizes: [] int, dsetname: string, ty, byteLength=-1) throws {
-    extern proc c_readColumnByName(filename, arr_chpl, colNum, numElems, startIdx, batchSize, byteLength, errMsg): int;
+  proc isFixedWidth(ty: ArrowTypes): bool {
+    return ty == ArrowTypes.int64 || ty == ArrowTypes.int32 ||
+           ty == ArrowTypes.uint64 || ty == ArrowTypes.uint32 ||
+           ty == ArrowTypes.boolean || ty == ArrowTypes.double ||
+           ty == ArrowTypes.float || ty == ArrowTypes.decimal ||
+           isTimeType(ty);
+  }
+
+  // Time columns are read as int64 nanoseconds, whatever unit they are
+  // stored in, and returned as Datetime or Timedelta
+  proc isTimeType(ty: ArrowTypes): bool {
+    return ty == ArrowTypes.timestamp || ty == ArrowTypes.date || ty == ArrowTypes.duration;
+  }
+
+  // Decimals are read as their unscaled values, as int64 up to
+  // DECIMAL_INT64_PRECISION and as bigint beyond that
+  proc isBigintDecimal(ty: ArrowTypes, precision: int): bool {
+    return ty == ArrowTypes.decimal && precision > DECIMAL_INT64_PRECISION;
+  }
+
+  proc createFixedWidthEntry(len: int, ty: ArrowTypes): shared GenSymEntry throws {
+    select ty {
+      when ArrowTypes.int64, ArrowTypes.int32, ArrowTypes.decimal,
+           ArrowTypes.timestamp, ArrowTypes.date, ArrowTypes.duration do return createSymEntry(len, int);
+      when ArrowTypes.uint64, ArrowTypes.uint32 do return createSymEntry(len, uint);
+      when ArrowTypes.boolean do return createSymEntry(len, bool);
+      otherwise do return createSymEntry(len, real);
+    }
+  }
+
+  proc fixedWidthEntryPtr(entry: borrowed GenSymEntry, ty: ArrowTypes, idx: int): c_ptr_void throws {
+    select ty {
+      when ArrowTypes.int64, ArrowTypes.int32, ArrowTypes.decimal,
+           ArrowTypes.timestamp, ArrowTypes.date, ArrowTypes.duration do
+        return c_ptrTo(toSymEntry(entry, int).a[idx]): c_ptr_void;
+      when ArrowTypes.uint64, ArrowTypes.uint32 do
+        return c_ptrTo(toSymEntry(entry, uint).a[idx]): c_ptr_void;
+      when ArrowTypes.boolean do
+        return c_ptrTo(toSymEntry(entry, bool).a[idx]): c_ptr_void;
+      otherwise do
+        return c_ptrTo(toSymEntry(entry, real).a[idx]): c_ptr_void;
+    }
+  }
+
+  // Read several fixed width datasets with one pass over the row groups
+  // of each file, rather than one pass per dataset. The entries must all
+  // have the same length so that they share a distribution.
+  // validEntries is either empty or holds a bool entry for each dataset,
+  // which is set to whether each row is non-null. The validity is decoded
+  // into a bitmap in the same pass as the values.
+  proc readFilesByNames(entries: list(shared GenSymEntry), validEntries: list(shared GenSymEntry),
+                        filenames: [] string, sizes: [] int, starts: [] int,
+                        dsetnames: [] string, types: [] ArrowTypes, byteLengths: [] int) throws {
+    extern proc c_readColumnsByName(filename, chpl_arrs, chpl_validities, column_names, byteLengths,
+                                    numCols, numElems, startIdx, batchSize, numThreads, errMsg): int;
     var (subdoms, length) = getSubdomains(sizes);
     var fileOffsets = (+ scan sizes) - sizes;
-    
-    coforall loc in A.targetLocales() with (ref A) do on loc {
+    const ncols = entries.size;
+    const withValidity = validEntries.size > 0;
+    const D = makeDistDom(length);
+
+    coforall loc in D.targetLocales() do on loc {
       var locFiles = filenames;
       var locFiledoms = subdoms;
       var locOffsets = fileOffsets;
-      
-      forall (off, filedom, filename) in zip(locOffsets, locFiledoms, locFiles) {
-        for locdom in A.localSubdomains() {
+      var locStarts = starts;
+      var locNames: [0..#ncols] string = dsetnames;
+      var locTypes: [0..#ncols] ArrowTypes = types;
+      var locByteLengths: [0..#ncols] int = byteLengths;
+      var c_names: [0..#ncols] c_string_ptr;
+      for i in 0..#ncols do c_names[i] = locNames[i].c_str();
+
+      forall (off, start, filedom, filename) in zip(locOffsets, locStarts, locFiledoms, locFiles) {
+        for locdom in D.localSubdomains() {
           const intersection = domain_intersection(locdom, filedom);
 
           if intersection.size > 0 {
             var pqErr = new parquetErrorMsg();
-            if c_readColumnByName(filename.localize().c_str(), c_ptrTo(A[intersection.low]),
-                                  dsetname.localize().c_str(), intersection.size, intersection.low - off,
-                                  batchSize, byteLength,
-                                  c_ptrTo(pqErr.errMsg)) == ARROWERROR {
+            var ptrs: [0..#ncols] c_ptr_void;
+            for i in 0..#ncols do
+              ptrs[i] = fixedWidthEntryPtr(entries[i].borrow(), locTypes[i], intersection.low);
+            const nBitmapBytes = if withValidity then (intersection.size + 7) / 8 else 0;
+            var bitmaps: [0..#ncols, 0..#nBitmapBytes] uint(8);
+            var validPtrs: [0..#ncols] c_ptr_void;
+            if withValidity then
+              for i in 0..#ncols do validPtrs[i] = c_ptrTo(bitmaps[i, 0]): c_ptr_void;
+
+            if c_readColumnsByName(filename.localize().c_str(), c_ptrTo(ptrs), c_ptrTo(validPtrs),
+                                   c_ptrTo(c_names), c_ptrTo(locByteLengths), ncols, intersection.size,
+                                   start + intersection.low - off, batchSize, readThreads,
+                                   c_ptrTo(pqErr.errMsg)) == ARROWERROR {
               pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
             }
+            if withValidity {
+              for i in 0..#ncols {
+                ref V = toSymEntry(validEntries[i].borrow(), bool).a;
+                forall k in 0..#intersection.size do
+                  V[intersection.low + k] = ((bitmaps[i, k / 8] >> (k % 8)) & 1) == 1;
+              }
+            }
           }
         }
       }
-      
     }
   }
 
-  proc readStrFilesByName(A: [] ?t, filenames: [] string, sizes: [] int, dsetname: string, ty) throws {
-    extern proc c_readColumnByName(filename, arr_chpl, colNum, numElems, startIdx, batchSize, byteLength, errMsg): int;
+  // Read a decimal dataset too wide for int64 as a bigint array. Each
+  // value is read as the 64-bit limbs of its unscaled value, least
+  // significant first, which are assembled on the locale that owns it.
+  // If valid isn't empty, it is set to whether each value is non-null.
+  proc readDecimalFilesAsBigint(filenames: [] string, sizes: [] int, starts: [] int, len: int,
+                                dsetname: string, byteLength: int, precision: int,
+                                ref valid: [] bool) throws {
+    extern proc c_readColumnsByName(filename, chpl_arrs, chpl_validities, column_names, byteLengths,
+                                    numCols, numElems, startIdx, batchSize, numThreads, errMsg): int;
     var (subdoms, length) = getSubdomains(sizes);
-    
-    coforall loc in A.targetLocales() do on loc {
+    var fileOffsets = (+ scan sizes) - sizes;
+    const numLimbs = if precision <= 38 then 2 else 4;
+    const withValidity = valid.size > 0;
+    var A = makeDistArray(len, bigint);
+
+    coforall loc in A.targetLocales() with (ref A, ref valid) do on loc {
       var locFiles = filenames;
       var locFiledoms = subdoms;
+      var locOffsets = fileOffsets;
+      var locStarts = starts;
+      var locName = dsetname;
+      var locByteLength = byteLength;
 
-      forall (filedom, filename) in zip(locFiledoms, locFiles) {
+      forall (off, start, filedom, filename) in zip(locOffsets, locStarts, locFiledoms, locFiles) {
         for locdom in A.localSubdomains() {
           const intersection = domain_intersection(locdom, filedom);
 
           if intersection.size > 0 {
             var pqErr = new parquetErrorMsg();
-            var col: [filedom] t;
+            var limbs: [0..#(intersection.size * numLimbs)] uint;
+            var bitmap: [0..#(if withValidity then (intersection.size + 7) / 8 else 0)] uint(8);
+            var c_name = locName.c_str();
+            var ptr = c_ptrTo(limbs): c_ptr_void;
+            var validPtr: c_ptr_void = if withValidity then c_ptrTo(bitmap): c_ptr_void else nil;
+            if c_readColumnsByName(filename.localize().c_str(), c_ptrTo(ptr), c_ptrTo(validPtr),
+                                   c_ptrTo(c_name), c_ptrTo(locByteLength), 1, intersection.size,
+                                   start + intersection.low - off, batchSize, readThreads,
+                                   c_ptrTo(pqErr.errMsg)) == ARROWERROR {
+              pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
+            }
+
+            forall k in 0..#intersection.size with (var limb: bigint) {
+              ref b = A[intersection.low + k];
+              b = 0;
+              for l in 0..#numLimbs by -1 {
+                b <<= 64;
+                limb = limbs[k * numLimbs + l];
+                b += limb;
+              }
+              // the limbs are two's complement
+              if (limbs[k * numLimbs + numLimbs - 1] >> 63) == 1 {
+                limb = 1;
+                limb <<= 64 * numLimbs;
+                b -= limb;
+              }
+            }
+            if withValidity then
+              forall k in 0..#intersection.size do
+                valid[intersection.low + k] = ((bitmap[k / 8] >> (k % 8)) & 1) == 1;
+          }
+        }
+      }
+    }
+    return createSymEntry(A, -1);
+  }
+
+  // Whether dsetname is dictionary encoded throughout a file
+  proc isDictionaryEncoded(filename: string, dsetname: string): bool throws {
+    extern proc c_isDictionaryEncoded(filename, colname, errMsg): c_int;
+    var pqErr = new parquetErrorMsg();
+    var res = c_isDictionaryEncoded(filename.localize().c_str(), dsetname.localize().c_str(),
+                                    c_ptrTo(pqErr.errMsg));
+    if res == ARROWERROR {
+      pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
+    }
+    return res != 0;
+  }
+
+  // Whether dsetname is dictionary encoded throughout every file that is
+  // read, so that it can be read as a Categorical straight from the
+  // dictionaries. Files without rows to read, including the ones skipped
+  // after an error, are not checked. The files are spread over the
+  // locales like the footer reads.
+  proc isDictionaryEncoded(filenames: [] string, sizes: [] int, dsetname: string): bool throws {
+    var encoded: [filenames.domain] bool = true;
+    var errs: [filenames.domain] string;
+    coforall loc in Locales with (ref encoded, ref errs) do on loc {
+      forall i in filenames.domain {
+        if i % numLocales == here.id && sizes[i] > 0 {
+          try {
+            encoded[i] = isDictionaryEncoded(filenames[i], dsetname);
+          } catch e : Error {
+            errs[i] = e.message();
+          }
+        }
+      }
+    }
+    for (filename, err) in zip(filenames, errs) {
+      if err != "" then
+        throw getErrorWithContext(
+                       msg="Failed to check the encoding of %s in %s: %s".doFormat(dsetname, filename, err),
+                       getLineNumber(),
+                       getRoutineName(),
+                       getModuleName(),
+                       errorClass="ParquetError");
+    }
+    return && reduce encoded;
+  }
 
-            if c_readColumnByName(filename.localize().c_str(), c_ptrTo(col),
-                                  dsetname.localize().c_str(), intersection.size, 0,
-                                  batchSize, -1, c_ptrTo(pqErr.errMsg)) == ARROWERROR {
+  // Read a dictionary encoded string dataset as a Categorical. Each file
+  // slice returns its codes into the dictionary of the row groups it read,
+  // so strings are only materialized once per dictionary entry rather than
+  // once per row. The slice dictionaries are then uniqued to build the
+  // categories and the codes are remapped. "N/A" for nulls is appended
+  // after the uniquing, so that a real "N/A" value keeps its own code.
+  proc readDictFilesAsCategorical(filenames: [] string, sizes: [] int, starts: [] int, len: int,
+                                  dsetname: string, st: borrowed SymTab): string throws {
+    extern proc c_readDictColumnByName(filename, chpl_codes, colname, numElems, startIdx,
+                                       batchSize, dictValues, dictNumBytes, errMsg): int;
+    extern proc c_free_string(ptr);
+    var (subdoms, length) = getSubdomains(sizes);
+    var fileOffsets = (+ scan sizes) - sizes;
+    const nfiles = filenames.size;
+    var codes = makeDistArray(len, int);
+
+    // one slice per (locale, file), the dictionary pointers are only
+    // valid on the locale that read the slice
+    const sliceDom = {0..#(numLocales*nfiles)};
+    var sliceCats: [sliceDom] int;
+    var sliceBytes: [sliceDom] int;
+    var sliceVals: [sliceDom] c_ptr(uint(8));
+
+    coforall loc in codes.targetLocales() with (ref codes) do on loc {
+      var locFiles = filenames;
+      var locFiledoms = subdoms;
+      var locOffsets = fileOffsets;
+      var locStarts = starts;
+
+      forall (fi, off, start, filedom, filename) in zip(0..#nfiles, locOffsets, locStarts, locFiledoms, locFiles) {
+        for locdom in codes.localSubdomains() {
+          const intersection = domain_intersection(locdom, filedom);
+
+          if intersection.size > 0 {
+            var pqErr = new parquetErrorMsg();
+            var vals: c_ptr(uint(8));
+            var nBytes: int;
+            var nCats = c_readDictColumnByName(filename.localize().c_str(), c_ptrTo(codes[intersection.low]),
+                                               dsetname.localize().c_str(), intersection.size,
+                                               start + intersection.low - off, batchSize,
+                                               c_ptrTo(vals), c_ptrTo(nBytes), c_ptrTo(pqErr.errMsg));
+            if nCats == ARROWERROR {
               pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
             }
-            A[filedom] = col;
+            const s = here.id * nfiles + fi;
+            sliceCats[s] = nCats;
+            sliceBytes[s] = nBytes;
+            sliceVals[s] = vals;
+          }
+        }
+      }
+    }
+
+    // Gather the slice dictionaries into one Strings
+    const catStarts = (+ scan sliceCats) - sliceCats;
+    const byteStarts = (+ scan sliceBytes) - sliceBytes;
+    const numCats = + reduce sliceCats;
+    const numBytes = + reduce sliceBytes;
+    var dictSegs = makeDistArray(numCats, int);
+    var dictVals = makeDistArray(numBytes, uint(8));
+
+    coforall loc in codes.targetLocales() with (ref dictSegs, ref dictVals) do on loc {
+      forall fi in 0..#nfiles with (var segAgg = newDstAggregator(int),
+                                    var valAgg = newDstAggregator(uint(8))) {
+        const s = here.id * nfiles + fi;
+        const vals = sliceVals[s];
+        if vals != nil {
+          var c = catStarts[s];
+          const b = byteStarts[s];
+          for k in 0..#sliceBytes[s] {
+            if k == 0 || vals[k-1] == 0 {
+              segAgg.copy(dictSegs[c], b + k);
+              c += 1;
+            }
+            valAgg.copy(dictVals[b + k], vals[k]);
+          }
+          c_free_string(vals);
+        }
+      }
+    }
+
+    var dictEntry = new shared SegStringSymEntry(createSymEntry(dictSegs), createSymEntry(dictVals), string);
+    var dictStr = new SegString("", dictEntry);
+    var (uo, uv, _, inv) = uniqueGroup(dictStr, returnInverse=true);
+
+    // The categories are the unique values followed by "N/A" for nulls
+    const naValue = "N/A";
+    const naCode = uo.size;
+    var catSegs = makeDistArray(uo.size + 1, int);
+    var catVals = makeDistArray(uv.size + naValue.numBytes + 1, uint(8));
+    catSegs[0..#uo.size] = uo;
+    catSegs[naCode] = uv.size;
+    catVals[0..#uv.size] = uv;
+    for (k, v) in zip(0..#naValue.numBytes, naValue.bytes()) do
+      catVals[uv.size + k] = v;
+    var categories = getSegString(catSegs, catVals, st);
+
+    // Map the slice codes onto the categories
+    coforall loc in codes.targetLocales() with (ref codes) do on loc {
+      var locFiledoms = subdoms;
+      forall (fi, filedom) in zip(0..#nfiles, locFiledoms) with (var agg = newSrcAggregator(int)) {
+        const catStart = catStarts[here.id * nfiles + fi];
+        for locdom in codes.localSubdomains() {
+          for i in domain_intersection(locdom, filedom) {
+            if codes[i] < 0 then
+              codes[i] = naCode;
+            else
+              agg.copy(codes[i], inv[catStart + codes[i]]);
+          }
+        }
+      }
+    }
+
+    var codesEntry = createSymEntry(codes);
+    var codesName = st.nextName();
+    st.addEntry(codesName, codesEntry);
+    var naCodes = makeDistArray(1, int);
+    naCodes[0] = naCode;
+    var naCodesEntry = createSymEntry(naCodes);
+    var naCodesName = st.nextName();
+    st.addEntry(naCodesName, naCodesEntry);
+
+    var rtnMap: map(string, string);
+    rtnMap.add("codes", "created " + st.attrib(codesName));
+    rtnMap.add("categories", "created %s+created %?".doFormat(st.attrib(categories.name), categories.nBytes));
+    rtnMap.add("_akNAcode", "created " + st.attrib(naCodesName));
+    return formatJson(rtnMap);
+  }
+
+  // Read a string dataset with a single pass over each file that produces
+  // the string lengths and bytes together. Each file is read by the locale
+  // that owns its first row, and its bytes are copied into place once the
+  // byte offset of every file is known.
+  // If valid isn't empty, it is set to whether each string is non-null
+  proc readStrFilesAsSegString(filenames: [] string, sizes: [] int, starts: [] int, len: int,
+                               dsetname: string, st: borrowed SymTab, ref valid: [] bool) throws {
+    extern proc c_readStrColumnByName(filename, colname, chpl_lengths, chpl_validity, values,
+                                      numElems, startIdx, batchSize, errMsg): int;
+    extern proc c_free_string(ptr);
+    var (subdoms, length) = getSubdomains(sizes);
+    var entrySeg = createSymEntry(len, int);
+    var byteSizes: [filenames.domain] int;
+    var fileVals: [filenames.domain] c_ptr(uint(8)); // only valid on the reading locale
+    var fileLocs: [filenames.domain] int;
+
+    coforall loc in entrySeg.a.targetLocales() with (ref byteSizes, ref fileVals, ref fileLocs, ref valid) do on loc {
+      var locFiles = filenames;
+      var locFiledoms = subdoms;
+
+      forall (i, filedom, filename) in zip(sizes.domain, locFiledoms, locFiles) {
+        for locdom in entrySeg.a.localSubdomains() {
+          if filedom.size > 0 && locdom.contains(filedom.low) {
+            var pqErr = new parquetErrorMsg();
+            var lengths: [filedom] int;
+            var vals: c_ptr(uint(8));
+            const withValidity = valid.size > 0;
+            var bitmap: [0..#(if withValidity then (sizes[i] + 7) / 8 else 0)] uint(8);
+            var validPtr: c_ptr_void = if withValidity then c_ptrTo(bitmap): c_ptr_void else nil;
+            var nBytes = c_readStrColumnByName(filename.localize().c_str(), dsetname.localize().c_str(),
+                                               c_ptrTo(lengths), validPtr, c_ptrTo(vals), sizes[i],
+                                               starts[i], batchSize, c_ptrTo(pqErr.errMsg));
+            if nBytes == ARROWERROR {
+              pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
+            }
+            entrySeg.a[filedom] = lengths;
+            if withValidity then
+              valid[filedom] = [k in 0..#sizes[i]] ((bitmap[k / 8] >> (k % 8)) & 1) == 1;
+            byteSizes[i] = nBytes;
+            fileVals[i] = vals;
+            fileLocs[i] = here.id;
           }
         }
       }
     }
+    entrySeg.a = (+ scan entrySeg.a) - entrySeg.a;
+
+    const byteStarts = (+ scan byteSizes) - byteSizes;
+    var entryVal = createSymEntry((+ reduce byteSizes), uint(8));
+    coforall loc in entrySeg.a.targetLocales() do on loc {
+      forall i in filenames.domain {
+        const vals = fileVals[i];
+        if vals != nil && fileLocs[i] == here.id {
+          const start = byteStarts[i];
+          forall k in 0..#byteSizes[i] with (var agg = newDstAggregator(uint(8))) do
+            agg.copy(entryVal.a[start + k], vals[k]);
+          c_free_string(vals);
+        }
+      }
+    }
+    return assembleSegStringFromParts(entrySeg, entryVal, st);
   }
 
   proc computeIdx(offsets: [] int, val: int): int throws {
@@ -337,16 +781,28 @@ module ParquetMsg {
     return size;
   }
 
-  proc getArrType(filename: string, colname: string) throws {
-    extern proc c_getType(filename, colname, errMsg): c_int;
+  // The footer information for the columns dsetnames of a file, along
+  // with its number of rows, from a single call into Arrow
+  proc getFileInfo(filename: string, dsetnames: [] string, ref infos: [] ColumnInfo): int throws {
+    extern proc c_getFileInfo(filename, column_names, numCols, colInfo, rowGroupRows,
+                              numRowGroups, errMsg): int;
+    const ncols = dsetnames.size;
+    var locNames: [0..#ncols] string = dsetnames;
+    var c_names: [0..#ncols] c_string_ptr;
+    for i in 0..#ncols do c_names[i] = locNames[i].c_str();
+    var numRowGroups: int;
     var pqErr = new parquetErrorMsg();
-    var arrType = c_getType(filename.localize().c_str(),
-                            colname.localize().c_str(),
-                            c_ptrTo(pqErr.errMsg));
-    if arrType == ARROWERROR {
+
+    var size = c_getFileInfo(filename.localize().c_str(), c_ptrTo(c_names), ncols,
+                             c_ptrTo(infos), nil: c_ptr(c_ptr_void), c_ptrTo(numRowGroups),
+                             c_ptrTo(pqErr.errMsg));
+    if size == ARROWERROR {
       pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
     }
-    
+    return size;
+  }
+
+  proc toArrowType(arrType: c_int): ArrowTypes {
     if arrType == ARROWINT64 then return ArrowTypes.int64;
     else if arrType == ARROWINT32 then return ArrowTypes.int32;
     else if arrType == ARROWUINT32 then return ArrowTypes.uint32;
@@ -357,6 +813,24 @@ module ParquetMsg {
     else if arrType == ARROWFLOAT then return ArrowTypes.float;
     else if arrType == ARROWLIST then return ArrowTypes.list;
     else if arrType == ARROWDECIMAL then return ArrowTypes.decimal;
+    else if arrType == ARROWTIMESTAMP then return ArrowTypes.timestamp;
+    else if arrType == ARROWDATE then return ArrowTypes.date;
+    else if arrType == ARROWDURATION then return ArrowTypes.duration;
+    return ArrowTypes.notimplemented;
+  }
+
+  proc getArrType(filename: string, colname: string) throws {
+    extern proc c_getType(filename, colname, errMsg): c_int;
+    var pqErr = new parquetErrorMsg();
+    var arrType = c_getType(filename.localize().c_str(),
+                            colname.localize().c_str(),
+                            c_ptrTo(pqErr.errMsg));
+    if arrType == ARROWERROR {
+      pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
+    }
+    
+    const ty = toArrowType(arrType);
+    if ty != ArrowTypes.notimplemented then return ty;
     throw getErrorWithContext(
                   msg="Unrecognized Parquet data type",
                   getLineNumber(),
@@ -371,15 +845,7 @@ module ParquetMsg {
     var pqErr = new parquetErrorMsg();
     
     var t = c_getListType(filename.localize().c_str(), dsetname.localize().c_str(), c_ptrTo(pqErr.errMsg));
-    if t == ARROWINT64 then return ArrowTypes.int64;
-    else if t == ARROWINT32 then return ArrowTypes.int32;
-    else if t == ARROWUINT32 then return ArrowTypes.uint32;
-    else if t == ARROWUINT64 then return ArrowTypes.uint64;
-    else if t == ARROWBOOLEAN then return ArrowTypes.boolean;
-    else if t == ARROWSTRING then return ArrowTypes.stringArr;
-    else if t == ARROWDOUBLE then return ArrowTypes.double;
-    else if t == ARROWFLOAT then return ArrowTypes.float;
-    return ArrowTypes.notimplemented;
+    return toArrowType(t);
   }
 
   proc toCDtype(dtype: string) throws {
@@ -681,17 +1147,102 @@ module ParquetMsg {
     return formatJson(rtnmap);
   }
 
-  proc populateTagData(A, filenames: [?fD] string, sizes) throws {
+  // The (first row, number of rows) ranges of a file that may satisfy a
+  // filter, from its row group and page statistics
+  proc getFilteredRanges(filename: string, filterCols: [] string, filterKinds: [] int,
+                         filterNumValues: [] int, filterValues: [] string): list(2*int) throws {
+    extern proc c_getFilteredRowRanges(filename, column_names, pred_kinds, pred_num_values,
+                                       pred_values, numPreds, ranges, errMsg): int;
+    extern proc c_free_string(ptr);
+    const npreds = filterCols.size;
+    var locCols: [0..#npreds] string = filterCols;
+    var c_cols: [0..#npreds] c_string_ptr;
+    for i in 0..#npreds do c_cols[i] = locCols[i].c_str();
+    var locValues: [0..#filterValues.size] string = filterValues;
+    var c_values: [0..#filterValues.size] c_string_ptr;
+    for i in 0..#filterValues.size do c_values[i] = locValues[i].c_str();
+    var kinds: [0..#npreds] int = filterKinds;
+    var numValues: [0..#npreds] int = filterNumValues;
+
+    var pqErr = new parquetErrorMsg();
+    var ranges: c_ptr(int);
+    var nranges = c_getFilteredRowRanges(filename.localize().c_str(), c_ptrTo(c_cols),
+                                         c_ptrTo(kinds), c_ptrTo(numValues),
+                                         c_ptrTo(c_values), npreds, c_ptrTo(ranges),
+                                         c_ptrTo(pqErr.errMsg));
+    if nranges == ARROWERROR {
+      pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
+    }
+    var ret: list(2*int);
+    for r in 0..#nranges do ret.pushBack((ranges[2*r], ranges[2*r+1]));
+    c_free_string(ranges);
+    return ret;
+  }
+
+  // The rows of each file that may satisfy a filter, as pieces of files
+  // given by the file, the first row and the number of rows. Without a
+  // filter every file is a single piece. The tag of a piece is the index
+  // of its file. The files are spread over the locales like the footer
+  // reads.
+  proc getFilteredPieces(filenames: [] string, sizes: [] int, filterCols: [] string,
+                         filterKinds: [] int, filterNumValues: [] int, filterValues: [] string) throws {
+    if filterCols.size == 0 {
+      var starts: [sizes.domain] int;
+      var tags: [sizes.domain] int = sizes.domain;
+      return (filenames, starts, sizes, tags);
+    }
+
+    var fileRanges: [filenames.domain] list(2*int);
+    var errs: [filenames.domain] string;
+    coforall loc in Locales with (ref fileRanges, ref errs) do on loc {
+      forall i in filenames.domain {
+        // files without rows to read include the ones skipped after an error
+        if i % numLocales == here.id && sizes[i] > 0 {
+          try {
+            fileRanges[i] = getFilteredRanges(filenames[i], filterCols, filterKinds,
+                                              filterNumValues, filterValues);
+          } catch e : Error {
+            errs[i] = e.message();
+          }
+        }
+      }
+    }
+    for (filename, err) in zip(filenames, errs) {
+      if err != "" then
+        throw getErrorWithContext(
+                       msg="Failed to filter the row groups of %s: %s".doFormat(filename, err),
+                       getLineNumber(),
+                       getRoutineName(),
+                       getModuleName(),
+                       errorClass="ParquetError");
+    }
+
+    var pieceFiles: list(string);
+    var pieceStarts, pieceSizes, pieceTags: list(int);
+    for (i, filename) in zip(filenames.domain, filenames) {
+      for (start, size) in fileRanges[i] {
+        pieceFiles.pushBack(filename);
+        pieceStarts.pushBack(start);
+        pieceSizes.pushBack(size);
+        pieceTags.pushBack(i);
+      }
+    }
+    pqLogger.debug(getModuleName(),getRoutineName(),getLineNumber(),
+                   "filters kept %i of %i rows".doFormat(+ reduce pieceSizes.toArray(), + reduce sizes));
+    return (pieceFiles.toArray(), pieceStarts.toArray(), pieceSizes.toArray(), pieceTags.toArray());
+  }
+
+  proc populateTagData(A, tags: [] int, sizes) throws {
     var (subdoms, length) = getSubdomains(sizes);
     var fileOffsets = (+ scan sizes) - sizes;
     
     coforall loc in A.targetLocales() do on loc {
-      var locFiles = filenames;
+      var locTags = tags;
       var locFiledoms = subdoms;
       var locOffsets = fileOffsets;
       
       try {
-        forall (off, filedom, filename, tag) in zip(locOffsets, locFiledoms, locFiles, 0..) {
+        forall (off, filedom, tag) in zip(locOffsets, locFiledoms, locTags) {
           for locdom in A.localSubdomains() {
             const intersection = domain_intersection(locdom, filedom);
 
@@ -709,12 +1260,51 @@ module ParquetMsg {
     var repMsg: string;
     var tagData: bool = msgArgs.get("tag_data").getBoolValue();
     var strictTypes: bool = msgArgs.get("strict_types").getBoolValue();
+    var categoricalStrings: bool = if msgArgs.contains("categorical_strings")
+                                     then msgArgs.get("categorical_strings").getBoolValue()
+                                     else false;
+
+    // Whether to return whether each row is non-null along with the
+    // fixed width and string datasets, as <dataset>_validity
+    var withValidity: bool = if msgArgs.contains("validity")
+                               then msgArgs.get("validity").getBoolValue()
+                               else false;
 
     var allowErrors: bool = msgArgs.get("allow_errors").getBoolValue(); // default is false
     if allowErrors {
         pqLogger.warn(getModuleName(), getRoutineName(), getLineNumber(), "Allowing file read errors");
     }
     
+    // Optional filter, predicates on columns that a row has to satisfy.
+    // Only row groups (and pages) that may hold matching rows are read.
+    var nfilters = if msgArgs.contains("filter_size")
+                     then msgArgs.get("filter_size").getIntValue()
+                     else 0;
+    var filterCols: [0..#nfilters] string;
+    var filterKinds: [0..#nfilters] int;
+    var filterNumValues: [0..#nfilters] int;
+    if nfilters > 0 {
+      filterCols = msgArgs.get("filter_cols").getList(nfilters);
+      for (kind, name) in zip(filterKinds, msgArgs.get("filter_kinds").getList(nfilters)) {
+        select name {
+          when "range" do kind = PREDRANGE;
+          when "min" do kind = PREDMIN;
+          when "max" do kind = PREDMAX;
+          when "in" do kind = PREDIN;
+          otherwise {
+            var errorMsg = "Unknown filter kind: %s".doFormat(name);
+            pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
+            return new MsgTuple(errorMsg, MsgType.ERROR);
+          }
+        }
+      }
+      for (n, val) in zip(filterNumValues, msgArgs.get("filter_num_values").getList(nfilters)) do
+        n = val:int;
+    }
+    var filterValues: [0..#(+ reduce filterNumValues)] string;
+    if filterValues.size > 0 then
+      filterValues = msgArgs.get("filter_values").getList(filterValues.size);
+
     var ndsets = msgArgs.get("dset_size").getIntValue();
     var nfiles = msgArgs.get("filename_size").getIntValue();
     var dsetlist: [0..#ndsets] string;
@@ -778,42 +1368,109 @@ module ParquetMsg {
     var fileErrorMsg:string = "";
     var sizes: [filedom] int;
     var types: [dsetdom] ArrowTypes;
-    var byteSizes: [filedom] int;
+    var listTypes: [dsetdom] ArrowTypes;
+    var byteLengths: [dsetdom] int;
+    var precisions: [dsetdom] int;
     
     var rnames: list((string, ObjType, string)); // tuple (dsetName, item type, id)
-    
-    for (dsetidx, dsetname) in zip(dsetdom, dsetnames) do {
-        types[dsetidx] = getArrType(filenames[0], dsetname);
-        for (i, fname) in zip(filedom, filenames) {
-            var hadError = false;
-            try {
-                sizes[i] = getArrSize(fname);
-            } catch e : Error {
-                // This is only type of error thrown by Parquet
-                fileErrorMsg = "Other error in accessing file %s: %s".doFormat(fname,e.message());
-                pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),fileErrorMsg);
-                hadError = true;
-                if !allowErrors { return new MsgTuple(fileErrorMsg, MsgType.ERROR); }
-            }
 
-            // This may need to be adjusted for this all-in-one approach
-            if hadError {
-              // Keep running total, but we'll only report back the first 10
-              if fileErrorCount < 10 {
-                fileErrors.pushBack(fileErrorMsg.replace("\n", " ").replace("\r", " ").replace("\t", " ").strip());
-              }
-              fileErrorCount += 1;
+    // Read the footer of every file once, spreading the files over the
+    // locales, and plan the read from that
+    var fileInfos: [filedom] [dsetdom] ColumnInfo;
+    var fileErrs: [filedom] string;
+    coforall loc in Locales with (ref sizes, ref fileInfos, ref fileErrs) do on loc {
+      var locNames = dsetnames;
+      forall i in filedom {
+        if i % numLocales == here.id {
+          var infos: [dsetdom] ColumnInfo;
+          try {
+            sizes[i] = getFileInfo(filenames[i], locNames, infos);
+            fileInfos[i] = infos;
+          } catch e : Error {
+            fileErrs[i] = e.message();
+          }
+        }
+      }
+    }
+
+    var infoIdx = -1; // the first file read without an error
+    for (i, fname) in zip(filedom, filenames) {
+        if fileErrs[i] != "" {
+            // This is only type of error thrown by Parquet
+            fileErrorMsg = "Other error in accessing file %s: %s".doFormat(fname,fileErrs[i]);
+            pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),fileErrorMsg);
+            if !allowErrors { return new MsgTuple(fileErrorMsg, MsgType.ERROR); }
+
+            // Keep running total, but we'll only report back the first 10
+            if fileErrorCount < 10 {
+              fileErrors.pushBack(fileErrorMsg.replace("\n", " ").replace("\r", " ").replace("\t", " ").strip());
             }
+            fileErrorCount += 1;
+        } else if infoIdx == -1 {
+            infoIdx = i;
         }
-        
-        var len = + reduce sizes;
+    }
+    if infoIdx == -1 {
+      var errorMsg = "None of the %i files could be read".doFormat(filenames.size);
+      pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
+      return new MsgTuple(errorMsg, MsgType.ERROR);
+    }
+
+    for dsetidx in dsetdom {
+      const info = fileInfos[infoIdx][dsetidx];
+      types[dsetidx] = toArrowType(info.typeCode);
+      listTypes[dsetidx] = toArrowType(info.listTypeCode);
+      byteLengths[dsetidx] = info.byteLength;
+      precisions[dsetidx] = info.precision;
+      if isTimeType(types[dsetidx]) then
+        pqLogger.debug(getModuleName(),getRoutineName(),getLineNumber(),
+                       "Reading %s as nanoseconds from time unit %i (time zone: %?)".doFormat(
+                       dsetnames[dsetidx], info.timeUnit, info.hasTimeZone != 0));
+    }
+
+    if nfilters > 0 && || reduce (types == ArrowTypes.list) {
+      var errorMsg = "Filters are not supported when reading list datasets";
+      pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
+      return new MsgTuple(errorMsg, MsgType.ERROR);
+    }
+    var (readFiles, readStarts, readSizes, readTags) = getFilteredPieces(filenames, sizes, filterCols,
+                                                                        filterKinds, filterNumValues,
+                                                                        filterValues);
+    var len = + reduce readSizes;
+
+    // Read all of the fixed width datasets together so that each row
+    // group is only visited once for all of them
+    var fixedEntries: list(shared GenSymEntry);
+    var fixedValidEntries: list(shared GenSymEntry);
+    var fixedPos: [dsetdom] int = -1; // position of a dataset in fixedEntries
+    {
+      var fixedNames: list(string);
+      var fixedTypes: list(ArrowTypes);
+      var fixedByteLengths: list(int);
+      for (dsetidx, dsetname, ty) in zip(dsetdom, dsetnames, types) {
+        if isFixedWidth(ty) && !isBigintDecimal(ty, precisions[dsetidx]) {
+          fixedPos[dsetidx] = fixedEntries.size;
+          fixedEntries.pushBack(createFixedWidthEntry(len, ty));
+          if withValidity then
+            fixedValidEntries.pushBack(createSymEntry(len, bool));
+          fixedNames.pushBack(dsetname);
+          fixedTypes.pushBack(ty);
+          fixedByteLengths.pushBack(byteLengths[dsetidx]);
+        }
+      }
+      if fixedEntries.size > 0 then
+        readFilesByNames(fixedEntries, fixedValidEntries, readFiles, readSizes, readStarts,
+                         fixedNames.toArray(), fixedTypes.toArray(), fixedByteLengths.toArray());
+    }
+
+    for (dsetidx, dsetname) in zip(dsetdom, dsetnames) do {
         var ty = types[dsetidx];
 
         // If tagging is turned on, tag the data
         if tagData {
           pqLogger.debug(getModuleName(),getRoutineName(),getLineNumber(), "Tagging Data with File Code");
           var tagEntry = createSymEntry(len, int);
-          populateTagData(tagEntry.a, filenames, sizes);
+          populateTagData(tagEntry.a, readTags, readSizes);
           var rname = st.nextName();
           st.addEntry(rname, tagEntry);
           rnames.pushBack(("Filename_Codes", ObjType.PDARRAY, rname));
@@ -822,48 +1479,48 @@ module ParquetMsg {
 
         // Only integer is implemented for now, do nothing if the Parquet
         // file has a different type
-        if ty == ArrowTypes.int64 || ty == ArrowTypes.int32 {
-          var entryVal = createSymEntry(len, int);
-          readFilesByName(entryVal.a, filenames, sizes, dsetname, ty);
+        if isBigintDecimal(ty, precisions[dsetidx]) {
+          var validEntry = createSymEntry(if withValidity then len else 0, bool);
+          var entryVal = readDecimalFilesAsBigint(readFiles, readSizes, readStarts, len, dsetname,
+                                                  byteLengths[dsetidx], precisions[dsetidx], validEntry.a);
           var valName = st.nextName();
           st.addEntry(valName, entryVal);
           rnames.pushBack((dsetname, ObjType.PDARRAY, valName));
-        } else if ty == ArrowTypes.uint64 || ty == ArrowTypes.uint32 {
-          var entryVal = createSymEntry(len, uint);
-          readFilesByName(entryVal.a, filenames, sizes, dsetname, ty);
-          if (ty == ArrowTypes.uint32){ // correction for high bit 
-            ref ea = entryVal.a;
-            // Access the high bit (64th bit) and shift it into the high bit for uint32 (32nd bit)
-            // Apply 32 bit mask to drop top 32 bits and properly store uint32
-            entryVal.a = ((ea & (2**63))>>32 | ea) & (2**32 -1);
+          if withValidity {
+            var validName = st.nextName();
+            st.addEntry(validName, validEntry);
+            rnames.pushBack((dsetname + "_validity", ObjType.PDARRAY, validName));
           }
+        } else if isFixedWidth(ty) {
+          // already read above
+          var entryVal = fixedEntries[fixedPos[dsetidx]];
           var valName = st.nextName();
           st.addEntry(valName, entryVal);
-          rnames.pushBack((dsetname, ObjType.PDARRAY, valName));
-        } else if ty == ArrowTypes.boolean {
-          var entryVal = createSymEntry(len, bool);
-          readFilesByName(entryVal.a, filenames, sizes, dsetname, ty);
-          var valName = st.nextName();
-          st.addEntry(valName, entryVal);
-          rnames.pushBack((dsetname, ObjType.PDARRAY, valName));
+          const objType = if ty == ArrowTypes.duration then ObjType.TIMEDELTA
+                          else if isTimeType(ty) then ObjType.DATETIME
+                          else ObjType.PDARRAY;
+          rnames.pushBack((dsetname, objType, valName));
+          if withValidity {
+            var validName = st.nextName();
+            st.addEntry(validName, fixedValidEntries[fixedPos[dsetidx]]);
+            rnames.pushBack((dsetname + "_validity", ObjType.PDARRAY, validName));
+          }
+        } else if ty == ArrowTypes.stringArr && categoricalStrings &&
+                  isDictionaryEncoded(filenames, sizes, dsetname) {
+          rnames.pushBack((dsetname, ObjType.CATEGORICAL,
+                           readDictFilesAsCategorical(readFiles, readSizes, readStarts, len, dsetname, st)));
         } else if ty == ArrowTypes.stringArr {
-          var entrySeg = createSymEntry(len, int);
-          byteSizes = calcStrSizesAndOffset(entrySeg.a, filenames, sizes, dsetname);
-          entrySeg.a = (+ scan entrySeg.a) - entrySeg.a;
-          
-          var entryVal = createSymEntry((+ reduce byteSizes), uint(8));
-          readStrFilesByName(entryVal.a, filenames, byteSizes, dsetname, ty);
-          
-          var stringsEntry = assembleSegStringFromParts(entrySeg, entryVal, st);
+          var validEntry = createSymEntry(if withValidity then len else 0, bool);
+          var stringsEntry = readStrFilesAsSegString(readFiles, readSizes, readStarts, len, dsetname, st,
+                                                     validEntry.a);
           rnames.pushBack((dsetname, ObjType.STRINGS, "%s+%?".doFormat(stringsEntry.name, stringsEntry.nBytes)));
-        } else if ty == ArrowTypes.double || ty == ArrowTypes.float {
-          var entryVal = createSymEntry(len, real);
-          readFilesByName(entryVal.a, filenames, sizes, dsetname, ty);
-          var valName = st.nextName();
-          st.addEntry(valName, entryVal);
-          rnames.pushBack((dsetname, ObjType.PDARRAY, valName));
+          if withValidity {
+            var validName = st.nextName();
+            st.addEntry(validName, validEntry);
+            rnames.pushBack((dsetname + "_validity", ObjType.PDARRAY, validName));
+          }
         } else if ty == ArrowTypes.list {
-          var list_ty = getListData(filenames[0], dsetname);
+          var list_ty = listTypes[dsetidx];
           if list_ty == ArrowTypes.notimplemented { // check for and skip further nested datasets
             pqLogger.info(getModuleName(),getRoutineName(),getLineNumber(),"Invalid list datatype found in %s. Skipping.".doFormat(dsetname));
           }
@@ -871,13 +1528,6 @@ module ParquetMsg {
             var create_str: string = parseListDataset(filenames, dsetname, list_ty, len, sizes, st);
             rnames.pushBack((dsetname, ObjType.SEGARRAY, create_str));
           }
-        } else if ty == ArrowTypes.decimal {
-          var byteLength = getByteLength(filenames[0], dsetname);
-          var entryVal = createSymEntry(len, real);
-          readFilesByName(entryVal.a, filenames, sizes, dsetname, ty, byteLength);
-          var valName = st.nextName();
-          st.addEntry(valName, entryVal);
-          rnames.pushBack((dsetname, ObjType.PDARRAY, valName));
         } else {
           var errorMsg = "DType %s not supported for Parquet reading".doFormat(ty);
           pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
@@ -908,38 +1558,6 @@ module ParquetMsg {
     return new list(datasets.split(","));
   }
 
-  // Decimal columns in Parquet have a fixed number of bytes based on the precision,
-  // but there isn't a way in Parquet to get the precision. Since the byte length
-  // will always remain the same for each precision value, here we just created a
-  // lookup table that maps from the precision to the byte value.
-  proc getByteLength(filename, colname) throws {
-    extern proc c_getPrecision(filename, colname, errMsg): int(32);
-    var pqErr = new parquetErrorMsg();
-    var res: c_ptr(uint(8));
-    defer {
-      extern proc c_free_string(ptr);
-      c_free_string(res);
-    }
-
-    var precision = c_getPrecision(filename.c_str(), colname.c_str(), c_ptrTo(pqErr.errMsg));
-    if precision < 3 then return 1;
-    else if precision < 5 then return 2;
-    else if precision < 7 then return 3;
-    else if precision < 10 then return 4;
-    else if precision < 12 then return 5;
-    else if precision < 15 then return 6;
-    else if precision < 17 then return 7;
-    else if precision < 19 then return 8;
-    else if precision < 22 then return 9;
-    else if precision < 24 then return 10;
-    else if precision < 27 then return 11;
-    else if precision < 29 then return 12;
-    else if precision < 32 then return 13;
-    else if precision < 34 then return 14;
-    else if precision < 36 then return 15;
-    return 16;
-  }
-
   proc pdarray_toParquetMsg(msgArgs: MessageArgs, st: borrowed SymTab): bool throws {
     var mode = msgArgs.get("mode").getIntValue();
     var filename: string = msgArgs.getValueOf("prefix");
@@ -1306,10 +1924,13 @@ module ParquetMsg {
 
   proc writeMultiColParquet(filename: string, col_names: [] string, 
                               ncols: int, sym_names: [] string, col_objTypes: [] string, targetLocales: [] locale, 
-                              compression: int, st: borrowed SymTab): bool throws {
+                              compressions: [] int, encodings: [] int, statOptions: [] int,
+                              sortingCols: [] int, st: borrowed SymTab): bool throws {
 
     extern proc c_writeMultiColToParquet(filename, column_names, ptr_arr, offset_arr, objTypes,
-                                      datatypes, segArr_sizes, colnum, numelems, rowGroupSize, compression, errMsg): int;
+                                      datatypes, segArr_sizes, colnum, numelems, rowGroupSize, compressions,
+                                      encodings, statOptions, sortingCols, numSortingCols,
+                                      numThreads, errMsg): int;
 
     var prefix: string;
     var extension: string;
@@ -1336,6 +1957,10 @@ module ParquetMsg {
       var segarray_sizes: [0..#ncols] int; // track # of values in each column. Used to determine last segment size.
 
       var my_column_names = col_names;
+      var my_compressions = compressions;
+      var my_encodings = encodings;
+      var my_stat_options = statOptions;
+      var my_sorting_cols = sortingCols;
       var c_names: [0..#ncols] c_string_ptr;
 
       var segment_ct: [0..#ncols] int;
@@ -1692,7 +2317,22 @@ module ParquetMsg {
         );
       }
       
-      var result: int = c_writeMultiColToParquet(fname.localize().c_str(), c_ptrTo(c_names), c_ptrTo(ptrList), c_ptrTo(segmentPtr), c_ptrTo(objTypes), c_ptrTo(datatypes), c_ptrTo(segarray_sizes), ncols, numelems, ROWGROUPS, compression, c_ptrTo(pqErr.errMsg));
+      // With several write threads a row group is buffered in memory
+      // until it is written, so its size is capped by the bytes of data
+      // per row rather than only the row count
+      var rowGroupSize = ROWGROUPS;
+      if writeThreads > 1 && numelems > 0 {
+        var locBytes = (+ reduce seg_sizes_str) + (+ reduce seg_sizes_bool) +
+                       8 * ((+ reduce seg_sizes_int) + (+ reduce seg_sizes_real));
+        for i in 0..#ncols {
+          if objTypes[i] == ObjType.PDARRAY: int then
+            locBytes += numelems * (if datatypes[i] == ARROWBOOLEAN then 1 else 8);
+        }
+        const bytesPerRow = max(1, (locBytes + numelems - 1) / numelems);
+        rowGroupSize = max(1, min(ROWGROUPS, writeRowGroupBytes / bytesPerRow));
+      }
+
+      var result: int = c_writeMultiColToParquet(fname.localize().c_str(), c_ptrTo(c_names), c_ptrTo(ptrList), c_ptrTo(segmentPtr), c_ptrTo(objTypes), c_ptrTo(datatypes), c_ptrTo(segarray_sizes), ncols, numelems, rowGroupSize, c_ptrTo(my_compressions), c_ptrTo(my_encodings), c_ptrTo(my_stat_options), c_ptrTo(my_sorting_cols), my_sorting_cols.size, writeThreads, c_ptrTo(pqErr.errMsg));
       if result == ARROWERROR {
         pqErr.parquetError(getLineNumber(), getRoutineName(), getModuleName());
       }
@@ -1775,15 +2415,25 @@ module ParquetMsg {
     // get list of objTypes for the names 
     const col_objType_strs: [0..#ncols] string = msgArgs.get("col_objtypes").getList(ncols);
 
-    // compression format as integer
-    const compression = msgArgs.getValueOf("compression").toUpper(): CompressionType;
+    // compression format and encoding of each column as integers
+    const col_compressions: [0..#ncols] int = [c in msgArgs.get("col_compressions").getList(ncols)] (c.toUpper(): CompressionType): int;
+    const col_encodings: [0..#ncols] int = [e in msgArgs.get("col_encodings").getList(ncols)] (e.toUpper(): EncodingType): int;
+
+    // STATS_* flags of each column, and the indices of the sorted columns
+    const col_stats: [0..#ncols] int = [o in msgArgs.get("col_stats").getList(ncols)] o: int;
+    const nsorting = if msgArgs.contains("sorting_size")
+                       then msgArgs.get("sorting_size").getIntValue()
+                       else 0;
+    var sorting_cols: [0..#nsorting] int;
+    if nsorting > 0 then
+      sorting_cols = [c in msgArgs.get("sorting_cols").getList(nsorting)] c: int;
 
     // use the first entry to identify target locales. Assuming all have same distribution
     var targetLocales = identifyTargetLocales(sym_names[0], col_objType_strs[0], st);
     
     var warnFlag: bool;
     try {
-      warnFlag = writeMultiColParquet(filename, col_names, ncols, sym_names, col_objType_strs, targetLocales, compression:int, st);
+      warnFlag = writeMultiColParquet(filename, col_names, ncols, sym_names, col_objType_strs, targetLocales, col_compressions, col_encodings, col_stats, sorting_cols, st);
     } catch e: FileNotFoundError {
       var errorMsg = "Unable to open %s for writing: %s".doFormat(filename,e.message());
       pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
@@ -1978,11 +2628,54 @@ module ParquetMsg {
     return new MsgTuple(repMsg,MsgType.NORMAL);
   }
 
+  // The scale of each of the decimal datasets in a file. Decimals are read
+  // as their unscaled values, so this is what turns them back into numbers.
+  proc decimalScalesMsg(cmd: string, msgArgs: borrowed MessageArgs, st: borrowed SymTab): MsgTuple throws {
+    var ndsets = msgArgs.get("dset_size").getIntValue();
+    var dsetnames: [0..#ndsets] string = msgArgs.get("dsets").getList(ndsets);
+    var filename: string = msgArgs.getValueOf("filename");
+    if isGlobPattern(filename) {
+      var tmp = glob(filename);
+      if tmp.size <= 0 {
+        var errorMsg = "Cannot retrieve filename from glob expression %s, check file name or format".doFormat(filename);
+        pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
+        return new MsgTuple(errorMsg, MsgType.ERROR);
+      }
+      sort(tmp);
+      filename = tmp[tmp.domain.first];
+    }
+
+    var infos: [0..#ndsets] ColumnInfo;
+    try {
+      getFileInfo(filename, dsetnames, infos);
+    } catch e : Error {
+      var errorMsg = "Could not read the schema of %s: %s".doFormat(filename, e.message());
+      pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
+      return new MsgTuple(errorMsg, MsgType.ERROR);
+    }
+
+    var scales: map(string, string);
+    for (dsetname, info) in zip(dsetnames, infos) {
+      if toArrowType(info.typeCode) != ArrowTypes.decimal {
+        var errorMsg = "Dataset %s is not a decimal column".doFormat(dsetname);
+        pqLogger.error(getModuleName(),getRoutineName(),getLineNumber(),errorMsg);
+        return new MsgTuple(errorMsg, MsgType.ERROR);
+      }
+      scales.add(dsetname, info.scale:string);
+    }
+    return new MsgTuple(formatJson(scales), MsgType.NORMAL);
+  }
+
   use CommandMap;
   registerFunction("readAllParquet", readAllParquetMsg, getModuleName());
   registerFunction("toParquet_multi", toParquetMultiColMsg, getModuleName());
   registerFunction("writeParquet", toparquetMsg, getModuleName());
   registerFunction("lspq", lspqMsg, getModuleName());
   registerFunction("getnullparquet", nullIndicesMsg, getModuleName());
+  registerFunction("decimalscalesparquet", decimalScalesMsg, getModuleName());
   ServerConfig.appendToConfigStr("ARROW_VERSION", getVersionInfo());
+  setFileCacheCapacity(fileCacheSize);
+  setMemoryMap(memoryMap);
+  setPreBuffer(preBuffer, holeSizeLimit, rangeSizeLimit, bufferedStreamSize);
+  setWriteBuffers(writeBuffers, writeBufferSize);
 }
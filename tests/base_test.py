@@ -28,6 +28,9 @@ class ArkoudaTest(unittest.TestCase):
     server = os.getenv("ARKOUDA_SERVER_HOST", "localhost")
     test_running_mode = TestRunningMode(os.getenv("ARKOUDA_RUNNING_MODE", "GLOBAL_SERVER"))
     timeout = int(os.getenv("ARKOUDA_CLIENT_TIMEOUT", 5))
+    # additional arguments for the arkouda_server a test class starts, only
+    # used in CLASS_SERVER mode
+    server_args = None
 
     @classmethod
     def setUpClass(cls):
@@ -44,7 +47,9 @@ class ArkoudaTest(unittest.TestCase):
         if TestRunningMode.CLASS_SERVER == ArkoudaTest.test_running_mode:
             try:
                 nl = get_arkouda_numlocales()
-                ArkoudaTest.server, _, _ = start_arkouda_server(numlocales=nl, port=ArkoudaTest.port)
+                ArkoudaTest.server, _, _ = start_arkouda_server(
+                    numlocales=nl, port=ArkoudaTest.port, server_args=cls.server_args
+                )
                 print(
                     "Started arkouda_server in TEST_CLASS mode with "
                     "host: {} port: {} locales: {}".format(ArkoudaTest.server, ArkoudaTest.port, nl)
@@ -73,6 +73,39 @@ class ParquetTest(ArkoudaTest):
                 pq_arr = ak.read_parquet(f"{tmp_dirname}/pq_test*", "test-dset")
                 self.assertListEqual(elems.to_list(), pq_arr.to_list())
 
+    def test_row_group_slices(self):
+        # uneven files of many small row groups, so the rows each locale
+        # reads start partway into a later row group of some file
+        sizes = [1013, 37, 2500, 401]
+        rng = np.random.default_rng(1)
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            frames = []
+            for i, n in enumerate(sizes):
+                df = pd.DataFrame(
+                    {
+                        "ints": rng.integers(-(2**40), 2**40, n),
+                        "small": rng.integers(0, 2**31, n).astype(np.uint32),
+                        "floats": rng.uniform(-1, 1, n),
+                        "bools": rng.integers(0, 2, n).astype(bool),
+                        "strs": [f"s{x}" for x in rng.integers(0, 10**6, n)],
+                    }
+                )
+                pq.write_table(
+                    pa.Table.from_pandas(df, preserve_index=False),
+                    f"{tmp_dirname}/rg_slices_{i:02d}.parquet",
+                    row_group_size=64,
+                )
+                frames.append(df)
+            expected = pd.concat(frames, ignore_index=True)
+
+            ak_data = ak.read_parquet(f"{tmp_dirname}/rg_slices_*")
+            for col in expected.columns:
+                self.assertListEqual(ak_data[col].to_list(), expected[col].to_list())
+
+            # a single dataset goes through the single column reader
+            strs = ak.read_parquet(f"{tmp_dirname}/rg_slices_*", "strs")
+            self.assertListEqual(strs.to_list(), expected["strs"].to_list())
+
     def test_wrong_dset_name(self):
         ak_arr = ak.randint(0, 2**32, SIZE)
         with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
@@ -143,6 +176,165 @@ class ParquetTest(ArkoudaTest):
             for key in ak_dict:
                 self.assertListEqual(ak_vals[key].to_list(), ak_dict[key].to_list())
 
+    def test_append_keeps_columns(self):
+        base = ak.arange(SIZE)
+        strs = ak.array(["", "abc", "de", ""] * (SIZE // 4))
+        floats = ak.linspace(0, 1, SIZE)
+
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            base.to_parquet(f"{tmp_dirname}/pq_append", "base", compression="snappy")
+            strs.to_parquet(f"{tmp_dirname}/pq_append", "strs", mode="append")
+            floats.to_parquet(f"{tmp_dirname}/pq_append", "floats", mode="append", compression="zstd")
+
+            # the existing column chunks are copied as is, so the files
+            # should still be readable by other parquet readers
+            for f in glob.glob(f"{tmp_dirname}/pq_append*"):
+                table = pq.read_table(f)
+                self.assertListEqual(sorted(table.column_names), ["base", "floats", "strs"])
+                # row groups are sized by their uncompressed column chunks
+                meta = pq.ParquetFile(f).metadata
+                for rg in range(meta.num_row_groups):
+                    row_group = meta.row_group(rg)
+                    self.assertEqual(
+                        row_group.total_byte_size,
+                        sum(
+                            row_group.column(i).total_uncompressed_size
+                            for i in range(row_group.num_columns)
+                        ),
+                    )
+
+            # the appended columns are declared like ones written in one pass
+            ak.to_parquet({"strs": strs, "floats": floats}, f"{tmp_dirname}/pq_one_pass")
+            appended = pq.ParquetFile(glob.glob(f"{tmp_dirname}/pq_append*")[0]).schema_arrow
+            one_pass = pq.ParquetFile(glob.glob(f"{tmp_dirname}/pq_one_pass*")[0]).schema_arrow
+            for name in ("strs", "floats"):
+                self.assertEqual(appended.field(name).type, one_pass.field(name).type)
+
+            ak_vals = ak.read_parquet(f"{tmp_dirname}/pq_append*")
+            self.assertListEqual(ak_vals["base"].to_list(), base.to_list())
+            self.assertListEqual(ak_vals["strs"].to_list(), strs.to_list())
+            self.assertListEqual(ak_vals["floats"].to_list(), floats.to_list())
+
+    def test_append_temp_file(self):
+        # appending writes to a uniquely named temporary file, leaving a
+        # user file with any other name alone
+        base = ak.arange(SIZE)
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            base.to_parquet(f"{tmp_dirname}/pq_tmp", "base")
+            files = sorted(glob.glob(f"{tmp_dirname}/pq_tmp*"))
+            for f in files:
+                with open(f"{f}.tmp", "w") as user_file:
+                    user_file.write("not parquet")
+            (base * 2).to_parquet(f"{tmp_dirname}/pq_tmp", "doubled", mode="append")
+
+            for f in files:
+                with open(f"{f}.tmp") as user_file:
+                    self.assertEqual(user_file.read(), "not parquet")
+            names = [os.path.basename(f) for f in files]
+            self.assertListEqual(
+                sorted(os.listdir(tmp_dirname)), sorted(names + [n + ".tmp" for n in names])
+            )
+            ak_vals = ak.read_parquet(files)
+            self.assertListEqual(ak_vals["doubled"].to_list(), (base * 2).to_list())
+
+    def test_encodings(self):
+        cols = {
+            "keys": ak.arange(SIZE),
+            "vals": ak.randint(0, 1, SIZE, dtype=ak.float64),
+            "strs": ak.array(["a", "b", "c", "d"] * (SIZE // 4)),
+            "other": ak.randint(0, 2**32, SIZE),
+        }
+        expected = {
+            "keys": "DELTA_BINARY_PACKED",
+            "vals": "BYTE_STREAM_SPLIT",
+            "strs": "RLE_DICTIONARY",
+        }
+
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            ak.to_parquet(cols, f"{tmp_dirname}/pq_auto", encoding="auto")
+            for f in glob.glob(f"{tmp_dirname}/pq_auto*"):
+                meta = pq.ParquetFile(f).metadata
+                for rg in range(meta.num_row_groups):
+                    for i in range(meta.num_columns):
+                        col = meta.row_group(rg).column(i)
+                        if col.path_in_schema in expected:
+                            self.assertIn(expected[col.path_in_schema], col.encodings)
+                        if col.path_in_schema == "vals":
+                            self.assertEqual(col.compression, "ZSTD")
+            ak_vals = ak.read_parquet(f"{tmp_dirname}/pq_auto*")
+            for key in cols:
+                self.assertListEqual(ak_vals[key].to_list(), cols[key].to_list())
+
+            ak.to_parquet(
+                cols,
+                f"{tmp_dirname}/pq_per_col",
+                compression={"keys": "snappy", "strs": "gzip"},
+                encoding={"keys": "delta", "vals": "plain"},
+            )
+            ak_vals = ak.read_parquet(f"{tmp_dirname}/pq_per_col*")
+            for key in cols:
+                self.assertListEqual(ak_vals[key].to_list(), cols[key].to_list())
+
+            with self.assertRaises(RuntimeError):
+                ak.to_parquet(cols, f"{tmp_dirname}/pq_bad", encoding={"strs": "delta"})
+            with self.assertRaises(ValueError):
+                ak.to_parquet(cols, f"{tmp_dirname}/pq_bad", encoding={"missing": "plain"})
+
+    def test_write_statistics(self):
+        cols = {
+            "keys": ak.arange(SIZE),
+            "strs": ak.random_strings_uniform(1, 10, SIZE),
+            "other": ak.randint(0, 2**32, SIZE),
+        }
+
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            ak.to_parquet(
+                cols,
+                f"{tmp_dirname}/pq_stats",
+                statistics={"strs": False},
+                page_index=True,
+                sorting_columns=["keys"],
+            )
+            for f in glob.glob(f"{tmp_dirname}/pq_stats*"):
+                meta = pq.ParquetFile(f).metadata
+                keys_idx = meta.schema.names.index("keys")
+                for rg in range(meta.num_row_groups):
+                    row_group = meta.row_group(rg)
+                    self.assertListEqual(
+                        [(s.column_index, s.descending) for s in row_group.sorting_columns],
+                        [(keys_idx, False)],
+                    )
+                    for i in range(meta.num_columns):
+                        col = row_group.column(i)
+                        self.assertEqual(col.is_stats_set, col.path_in_schema != "strs")
+                        # a column index holds page statistics, so only the
+                        # columns with statistics have one
+                        self.assertTrue(col.has_offset_index)
+                        if col.path_in_schema != "strs":
+                            self.assertTrue(col.has_column_index)
+            ak_vals = ak.read_parquet(f"{tmp_dirname}/pq_stats*")
+            for key in cols:
+                self.assertListEqual(ak_vals[key].to_list(), cols[key].to_list())
+
+            # the sorting hint is checked against the data
+            with self.assertRaises(RuntimeError):
+                ak.to_parquet(cols, f"{tmp_dirname}/pq_bad", sorting_columns=["other"])
+            with self.assertRaises(RuntimeError):
+                ak.to_parquet(cols, f"{tmp_dirname}/pq_bad", sorting_columns=["strs"])
+            # a NaN anywhere means the column has no defined sort order
+            for nan_at in (0, SIZE // 2, SIZE - 1):
+                floats = ak.linspace(0, 1, SIZE)
+                floats[nan_at] = np.nan
+                with self.assertRaises(RuntimeError):
+                    ak.to_parquet(
+                        {"floats": floats}, f"{tmp_dirname}/pq_bad", sorting_columns=["floats"]
+                    )
+            ak.to_parquet(
+                {"floats": ak.linspace(0, 1, SIZE)},
+                f"{tmp_dirname}/pq_sorted_floats",
+                sorting_columns=["floats"],
+            )
+
     def test_null_strings(self):
         datadir = "resources/parquet-testing"
         basename = "null-strings.parquet"
@@ -162,6 +354,28 @@ class ParquetTest(ArkoudaTest):
 
         self.assertListEqual([0, 1, 0, 1, 0, 1, 1], res.to_list())
 
+    def test_validity(self):
+        table = pa.table(
+            {
+                "ints": pa.array([1, None, 3, None, 5], type=pa.int64()),
+                "floats": pa.array([None, 2.5, np.nan, 4.5, None], type=pa.float64()),
+                "bools": pa.array([True, False, None, True, None]),
+                "strs": pa.array(["a", None, "", "d", None]),
+            }
+        )
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            pq.write_table(table, f"{tmp_dirname}/validity", row_group_size=2)
+            rd = ak.read_parquet(f"{tmp_dirname}/validity", validity=True)
+            for name in table.column_names:
+                expected = [v is not None for v in table[name].to_pylist()]
+                self.assertListEqual(rd[f"{name}_validity"].to_list(), expected)
+            self.assertListEqual(rd["ints"].to_list(), [1, 0, 3, 0, 5])
+
+            # the values are the same as without validity
+            plain = ak.read_parquet(f"{tmp_dirname}/validity")
+            self.assertListEqual(sorted(plain.keys()), sorted(table.column_names))
+            self.assertListEqual(rd["strs"].to_list(), plain["strs"].to_list())
+
     def test_append_empty(self):
         for dtype in TYPES:
             if dtype == "int64":
@@ -346,6 +560,45 @@ class ParquetTest(ArkoudaTest):
             for i in range(9):
                 self.assertListEqual(combo["ListCol"][i], ak_data[i].to_list())
 
+    def test_segarray_null_read(self):
+        # the segment sizes planned from the footers have to agree with the
+        # values read, for null and empty lists and null elements
+        ints = [[1, None, 2], None, [], [3], None, [None], [4, 5, 6]]
+        floats = [[1.5, None], None, [], [np.nan], [2.5, 3.5], [None], None]
+        strs = [["a", ""], None, [], [""], ["bc", "d"], None, ["e"]]
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            for i in range(3):
+                pq.write_table(
+                    pa.table(
+                        {
+                            "idx": np.arange(7) + 7 * i,
+                            "ints": pa.array(ints, pa.list_(pa.int64())),
+                            "floats": pa.array(floats, pa.list_(pa.float64())),
+                            "strs": pa.array(strs, pa.list_(pa.string())),
+                        }
+                    ),
+                    f"{tmp_dirname}/segarray_nulls_{i}.parquet",
+                    row_group_size=3,
+                )
+            # null lists are empty segments, null elements are dropped
+            # except in float lists, where they are NaN
+            expected_ints = [[v for v in x if v is not None] if x else [] for x in ints] * 3
+            expected_floats = [[np.nan if v is None else v for v in x] if x else [] for x in floats] * 3
+            expected_strs = [x if x else [] for x in strs] * 3
+
+            ak_data = ak.read_parquet(f"{tmp_dirname}/segarray_nulls_*")
+            self.assertListEqual(ak_data["idx"].to_list(), list(range(21)))
+            self.assertListEqual(ak_data["ints"].to_list(), expected_ints)
+            self.assertListEqual(ak_data["strs"].to_list(), expected_strs)
+            self.assertListEqual(ak_data["floats"].lengths.to_list(), [len(x) for x in expected_floats])
+            for x, y in zip(expected_floats, ak_data["floats"].to_list()):
+                self.assertTrue(np.array_equal(x, y, equal_nan=True))
+
+            for name, expected in (("ints", expected_ints), ("strs", expected_strs)):
+                ak_seg = ak.read_parquet(f"{tmp_dirname}/segarray_nulls_*", name)
+                self.assertIsInstance(ak_seg, ak.SegArray)
+                self.assertListEqual(ak_seg.to_list(), expected)
+
     def test_segarray_write(self):
         # integer test
         a = [0, 1, 2]
@@ -486,8 +739,10 @@ class ParquetTest(ArkoudaTest):
     def test_small_ints(self):
         df_pd = pd.DataFrame(
             {
+                "int8": pd.Series([2**7 - 1, -(2**7)], dtype=np.int8),
                 "int16": pd.Series([2**15 - 1, -(2**15)], dtype=np.int16),
                 "int32": pd.Series([2**31 - 1, -(2**31)], dtype=np.int32),
+                "uint8": pd.Series([2**7 - 1, 2**7], dtype=np.uint8),
                 "uint16": pd.Series([2**15 - 1, 2**15], dtype=np.uint16),
                 "uint32": pd.Series([2**31 - 1, 2**31], dtype=np.uint32),
             }
@@ -499,6 +754,277 @@ class ParquetTest(ArkoudaTest):
             for c in df_ak.columns:
                 self.assertListEqual(df_ak[c].to_list(), df_pd[c].to_list())
 
+    def test_float_reads(self):
+        # nulls and NaN over more than one batch of values per row group
+        n = 8195
+        rng = np.random.default_rng(8)
+        doubles = rng.uniform(-1e6, 1e6, n)
+        doubles[[0, 5, n - 1]] = [np.inf, -0.0, -np.inf]
+        doubles[3::10] = np.nan
+        nulls = np.zeros(n, dtype=bool)
+        nulls[7::9] = True
+        nulls[-3:] = True
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            pq.write_table(
+                pa.table(
+                    {
+                        "doubles": pa.array(doubles, pa.float64(), mask=nulls),
+                        "floats": pa.array(doubles.astype(np.float32), pa.float32(), mask=nulls),
+                    }
+                ),
+                f"{tmp_dirname}/float_reads",
+                row_group_size=5000,
+            )
+            ak_data = ak.read_parquet(f"{tmp_dirname}/float_reads", validity=True)
+            for name, expected in (("doubles", doubles), ("floats", doubles.astype(np.float32))):
+                expected = np.where(nulls, np.nan, expected.astype(np.float64))
+                ak_vals = ak_data[name].to_ndarray()
+                self.assertTrue(np.array_equal(ak_vals, expected, equal_nan=True))
+                real = ~np.isnan(expected)
+                self.assertTrue(np.array_equal(np.signbit(ak_vals[real]), np.signbit(expected[real])))
+                self.assertListEqual(ak_data[f"{name}_validity"].to_list(), (~nulls).tolist())
+
+    def test_nullable_fixed_reads(self):
+        # nulls read as zero/false, at the start and end, in runs across
+        # batches of 8192 values and row groups, and filling whole batches
+        n = 21000
+        rng = np.random.default_rng(22)
+        ints = rng.integers(-(2**62), 2**62, n)
+        ints[ints == 0] = 1
+        small = rng.integers(1, 2**31, n).astype(np.int32)
+        bools = np.ones(n, dtype=bool)
+        nulls = np.zeros(n, dtype=bool)
+        nulls[::13] = True
+        nulls[-1] = True
+        for start, stop in ((6995, 7005), (8188, 8196), (13998, 14002), (16380, 16390)):
+            nulls[start:stop] = True
+        nulls[9000:17192] = True
+        table = pa.table(
+            {
+                "int64": pa.array(ints, pa.int64(), mask=nulls),
+                "int32": pa.array(small, pa.int32(), mask=nulls),
+                "bool": pa.array(bools, pa.bool_(), mask=nulls),
+            }
+        )
+        expected = {
+            "int64": np.where(nulls, 0, ints).tolist(),
+            "int32": np.where(nulls, 0, small).tolist(),
+            "bool": (~nulls).tolist(),
+        }
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            for row_group_size in (7000, n):
+                fname = f"{tmp_dirname}/nullable_{row_group_size}"
+                pq.write_table(table, fname, row_group_size=row_group_size)
+                ak_data = ak.read_parquet(fname, validity=True)
+                for name in table.column_names:
+                    self.assertListEqual(ak_data[name].to_list(), expected[name])
+                    self.assertListEqual(ak_data[f"{name}_validity"].to_list(), (~nulls).tolist())
+                    self.assertListEqual(ak.read_parquet(fname, name).to_list(), expected[name])
+
+    def test_widened_ints(self):
+        # lengths that aren't a multiple of the vector width, within and
+        # across batches, and uint32 values with the high bit set
+        rng = np.random.default_rng(9)
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            for n in (1, 3, 5, 8191, 8197):
+                ints = rng.integers(-(2**31), 2**31, n).astype(np.int32)
+                uints = rng.integers(2**31, 2**32, n).astype(np.uint32)
+                ints[0], uints[0] = -(2**31), 2**32 - 1
+                uints[n // 2] = 2**31
+                nulls = np.zeros(n, dtype=bool)
+                nulls[1::4] = True
+                fname = f"{tmp_dirname}/widened_{n}"
+                pq.write_table(
+                    pa.table(
+                        {
+                            "ints": pa.array(ints, pa.int32()),
+                            "uints": pa.array(uints, pa.uint32()),
+                            "null_ints": pa.array(ints, pa.int32(), mask=nulls),
+                            "null_uints": pa.array(uints, pa.uint32(), mask=nulls),
+                        }
+                    ),
+                    fname,
+                    row_group_size=4099,
+                )
+                ak_data = ak.read_parquet(fname)
+                self.assertListEqual(ak_data["ints"].to_list(), ints.tolist())
+                self.assertListEqual(ak_data["uints"].to_list(), uints.tolist())
+                self.assertListEqual(
+                    ak_data["null_ints"].to_list(), np.where(nulls, 0, ints).tolist()
+                )
+                self.assertListEqual(
+                    ak_data["null_uints"].to_list(), np.where(nulls, 0, uints).tolist()
+                )
+
+    def test_categorical_strings(self):
+        words = np.array(["alpha", "beta", "gamma", "delta"])
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            # files with different dictionaries, row groups and a null
+            expected = []
+            for i in range(3):
+                vals = [str(w) for w in words[np.arange(i, i + 50) % (i + 2)]]
+                if i == 1:
+                    vals[7] = None
+                expected.extend(["N/A" if v is None else v for v in vals])
+                pq.write_table(
+                    pa.table({"strs": pa.array(vals, pa.string()), "ints": np.arange(50)}),
+                    f"{tmp_dirname}/cat_strs_{i}.parquet",
+                    row_group_size=16,
+                )
+            data = ak.read_parquet(f"{tmp_dirname}/cat_strs_*", categorical_strings=True)
+            self.assertIsInstance(data["strs"], ak.Categorical)
+            self.assertListEqual(data["strs"].to_list(), expected)
+            self.assertListEqual(data["ints"].to_list(), list(np.tile(np.arange(50), 3)))
+
+            # plain encoded strings still come back as Strings
+            pq.write_table(
+                pa.table({"strs": pa.array(list(words), pa.string())}),
+                f"{tmp_dirname}/plain_strs.parquet",
+                use_dictionary=False,
+            )
+            data = ak.read_parquet(f"{tmp_dirname}/plain_strs.parquet", categorical_strings=True)
+            self.assertIsInstance(data, ak.Strings)
+            self.assertListEqual(data.to_list(), list(words))
+
+            # a stored "N/A" keeps its own code, apart from the nulls
+            pq.write_table(
+                pa.table({"strs": pa.array(["N/A", None, "x", "N/A"], pa.string())}),
+                f"{tmp_dirname}/na_strs.parquet",
+            )
+            data = ak.read_parquet(f"{tmp_dirname}/na_strs.parquet", categorical_strings=True)
+            self.assertIsInstance(data, ak.Categorical)
+            codes = data.codes.to_list()
+            self.assertEqual(codes[0], codes[3])
+            self.assertEqual(codes[1], data._NAcode)
+            self.assertNotEqual(codes[0], data._NAcode)
+            self.assertListEqual(data.to_list(), ["N/A", "N/A", "x", "N/A"])
+
+            # files skipped with allow_errors are not checked for their encoding
+            bad = f"{tmp_dirname}/not_parquet.parquet"
+            with open(bad, "w") as f:
+                f.write("not a parquet file")
+            data = ak.read_parquet(
+                [f"{tmp_dirname}/cat_strs_{i}.parquet" for i in range(3)] + [bad],
+                categorical_strings=True,
+                allow_errors=True,
+            )
+            self.assertIsInstance(data["strs"], ak.Categorical)
+            self.assertListEqual(data["strs"].to_list(), expected)
+
+    def test_filters(self):
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            # sorted values, so each row group of 10 rows covers its own range
+            for i in range(2):
+                ints = np.arange(i * 50, (i + 1) * 50)
+                pq.write_table(
+                    pa.table({"ints": ints, "strs": pa.array([f"s{x:03d}" for x in ints])}),
+                    f"{tmp_dirname}/filters_{i}.parquet",
+                    row_group_size=10,
+                )
+            fname = f"{tmp_dirname}/filters_*"
+
+            # only the row groups that may hold a match are read
+            data = ak.read_parquet(fname, filters={"ints": (25, 34)})
+            self.assertListEqual(data["ints"].to_list(), list(range(20, 40)))
+            self.assertListEqual(data["strs"].to_list(), [f"s{x:03d}" for x in range(20, 40)])
+
+            data = ak.read_parquet(fname, filters={"ints": (None, 4), "strs": ["s003", "s071"]})
+            self.assertListEqual(data["ints"].to_list(), list(range(10)))
+
+            data = ak.read_parquet(
+                fname, datasets="ints", filters={"strs": {"s005", "s071"}}, tag_data=True
+            )
+            self.assertListEqual(data["ints"].to_list(), list(range(10)) + list(range(70, 80)))
+            self.assertListEqual(data["Filename_Codes"].to_list(), [0] * 10 + [1] * 10)
+
+            data = ak.read_parquet(fname, datasets="ints", filters={"ints": (1000, None)})
+            self.assertEqual(data.size, 0)
+
+            # with a page index, only the pages of a row group that may hold
+            # a match are read, here pages of 100 rows in one row group
+            fname = f"{tmp_dirname}/filters_pages.parquet"
+            pq.write_table(
+                pa.table({"ints": np.arange(1000)}),
+                fname,
+                use_dictionary=False,
+                write_batch_size=100,
+                data_page_size=1,
+                write_page_index=True,
+            )
+            self.assertTrue(pq.ParquetFile(fname).metadata.row_group(0).column(0).has_column_index)
+            data = ak.read_parquet(fname, datasets="ints", filters={"ints": (250, 260)})
+            self.assertListEqual(data.to_list(), list(range(200, 300)))
+            data = ak.read_parquet(fname, datasets="ints", filters={"ints": [50, 720]})
+            self.assertListEqual(data.to_list(), list(range(100)) + list(range(700, 800)))
+
+    def test_multi_column_read(self):
+        # every dataset of a file is read in one pass over its row groups
+        rng = np.random.default_rng(4)
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            expected = {"ints": [], "uints": [], "bools": [], "floats": [], "strs": []}
+            for i, n in enumerate([40, 3, 61]):
+                ints = [None if x % 5 == 0 else int(x) for x in rng.integers(0, 2**40, n)]
+                uints = [int(x) for x in rng.integers(2**63, 2**64 - 1, n, dtype=np.uint64)]
+                bools = [None if j % 4 == 1 else bool(j % 3) for j in range(n)]
+                floats = [None if j % 6 == 2 else float(x) for j, x in enumerate(rng.uniform(0, 1, n))]
+                strs = [[None, "", f"s{j}"][j % 3] for j in range(n)]
+                pq.write_table(
+                    pa.table(
+                        {
+                            "ints": pa.array(ints, pa.int64()),
+                            "uints": pa.array(uints, pa.uint64()),
+                            "bools": pa.array(bools, pa.bool_()),
+                            "floats": pa.array(floats, pa.float64()),
+                            "strs": pa.array(strs, pa.string()),
+                        }
+                    ),
+                    f"{tmp_dirname}/multi_col_{i}.parquet",
+                    row_group_size=7,
+                )
+                expected["ints"] += [0 if x is None else x for x in ints]
+                expected["uints"] += uints
+                expected["bools"] += [bool(x) for x in bools]
+                expected["floats"] += [np.nan if x is None else x for x in floats]
+                expected["strs"] += ["" if x is None else x for x in strs]
+
+            ak_data = ak.read_parquet(f"{tmp_dirname}/multi_col_*")
+            for col in ("ints", "uints", "bools", "strs"):
+                self.assertListEqual(ak_data[col].to_list(), expected[col])
+            self.assertTrue(
+                np.allclose(ak_data["floats"].to_ndarray(), expected["floats"], equal_nan=True)
+            )
+
+            # a subset of the datasets, in a different order
+            ak_data = ak.read_parquet(f"{tmp_dirname}/multi_col_*", ["uints", "ints"])
+            self.assertListEqual(ak_data["ints"].to_list(), expected["ints"])
+            self.assertListEqual(ak_data["uints"].to_list(), expected["uints"])
+
+    def test_string_read(self):
+        # lengths and bytes come from one pass over each row group
+        files = [
+            ["abc", None, "", "d" * 300, "\u00e9t\u00e9", None, "", "x"] * 5,
+            [None, "", None, ""],  # no bytes at all
+            [f"{i}" * (i % 11) for i in range(57)],
+        ]
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            for i, strs in enumerate(files):
+                pq.write_table(
+                    pa.table({"strs": pa.array(strs, pa.string()), "ints": np.arange(len(strs))}),
+                    f"{tmp_dirname}/str_read_{i}.parquet",
+                    row_group_size=6,
+                )
+            expected = ["" if x is None else x for strs in files for x in strs]
+
+            ak_strs = ak.read_parquet(f"{tmp_dirname}/str_read_*", "strs")
+            self.assertIsInstance(ak_strs, ak.Strings)
+            self.assertListEqual(ak_strs.to_list(), expected)
+
+            ak_data = ak.read_parquet(f"{tmp_dirname}/str_read_*")
+            self.assertListEqual(ak_data["strs"].to_list(), expected)
+            self.assertListEqual(
+                ak_data["ints"].to_list(), [i for strs in files for i in range(len(strs))]
+            )
+
     def test_read_nested(self):
         df = ak.DataFrame({"idx": ak.arange(5), "seg": ak.SegArray(ak.arange(0, 10, 2), ak.arange(10))})
         with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
@@ -572,7 +1098,77 @@ class ParquetTest(ArkoudaTest):
             pq.write_table(table, f"{tmp_dirname}/decimal")
             ak_data = ak.read(f"{tmp_dirname}/decimal")
             for i in range(1,39):
-                self.assertTrue(np.allclose(ak_data['decCol'+str(i)].to_ndarray(), data[i-1]))
+                self.assertListEqual(ak_data['decCol'+str(i)].to_list(), data[i-1])
+
+    def test_scaled_decimal_reads(self):
+        from decimal import Decimal
+
+        values = [Decimal("-12345.678"), None, Decimal("0.001"), Decimal("99999.999")]
+        wide = [Decimal("-" + "9" * 25 + ".12"), Decimal("1.5"), None, Decimal(2**70) / 100]
+        table = pa.table(
+            {
+                "narrow": pa.array(values, type=pa.decimal128(8, 3)),
+                "wide": pa.array(wide, type=pa.decimal128(38, 2)),
+            }
+        )
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            pq.write_table(table, f"{tmp_dirname}/scaled_decimal", row_group_size=3)
+            ak_data = ak.read_parquet(f"{tmp_dirname}/scaled_decimal", validity=True)
+            scales = ak.get_decimal_scales(f"{tmp_dirname}/scaled_decimal", ["narrow", "wide"])
+            self.assertDictEqual(scales, {"narrow": 3, "wide": 2})
+
+            self.assertEqual(ak_data["narrow"].dtype, ak.int64)
+            self.assertEqual(ak_data["wide"].dtype, ak.bigint)
+            for name, expected in (("narrow", values), ("wide", wide)):
+                unscaled = [0 if v is None else int(v.scaleb(scales[name])) for v in expected]
+                self.assertListEqual(ak_data[name].to_list(), unscaled)
+                self.assertListEqual(
+                    ak_data[f"{name}_validity"].to_list(), [v is not None for v in expected]
+                )
+
+    def test_time_reads(self):
+        stamps = pd.to_datetime(
+            ["2020-01-01 00:00:01.5", "1969-07-20 20:17:40", "2038-01-19 03:14:07"]
+        )
+        table = pa.table(
+            {
+                "ms": pa.array(stamps, type=pa.timestamp("ms")),
+                "us_utc": pa.array(stamps, type=pa.timestamp("us", tz="UTC")),
+                "day": pa.array(stamps.date, type=pa.date32()),
+                "elapsed": pa.array(stamps - stamps[0], type=pa.duration("us")),
+            }
+        )
+        day_ns = stamps.normalize().asi8
+        with tempfile.TemporaryDirectory(dir=ParquetTest.par_test_base_tmp) as tmp_dirname:
+            for int96 in (False, True):
+                fname = f"{tmp_dirname}/time_{int96}"
+                pq.write_table(table, fname, use_deprecated_int96_timestamps=int96)
+                ak_data = ak.read_parquet(fname)
+                for name in ("ms", "us_utc", "day"):
+                    self.assertIsInstance(ak_data[name], ak.Datetime)
+                self.assertIsInstance(ak_data["elapsed"], ak.Timedelta)
+                self.assertListEqual(ak_data["ms"].values.to_list(), stamps.asi8.tolist())
+                self.assertListEqual(ak_data["us_utc"].values.to_list(), stamps.asi8.tolist())
+                self.assertListEqual(ak_data["day"].values.to_list(), day_ns.tolist())
+                self.assertListEqual(
+                    ak_data["elapsed"].values.to_list(), (stamps - stamps[0]).asi8.tolist()
+                )
+
+            # filters on time datasets are in nanoseconds, whatever the stored
+            # unit; with a row group per row, only the matching rows are read
+            fname = f"{tmp_dirname}/time_filtered"
+            pq.write_table(table, fname, row_group_size=1)
+            for name, cond, rows in (
+                ("ms", (stamps[2], None), [2]),
+                ("ms", (None, int(stamps.asi8[1])), [1]),
+                ("us_utc", (stamps[1] + pd.Timedelta(1, "us"), stamps[2]), [0, 2]),
+                ("us_utc", [int(stamps.asi8[0])], [0]),
+                ("day", [int(day_ns[2])], [2]),
+                ("elapsed", (stamps[2] - stamps[0], None), [2]),
+                ("ms", (stamps[2] + pd.Timedelta(1, "s"), None), []),
+            ):
+                ak_data = ak.read_parquet(fname, filters={name: cond})
+                self.assertListEqual(ak_data["ms"].values.to_list(), stamps.asi8[rows].tolist())
 
     @pytest.mark.optional_parquet
     def test_against_standard_files(self):
@@ -618,3 +1214,259 @@ class ParquetTest(ArkoudaTest):
                 # this file should raise an error and not crash the server
                 with self.assertRaises(RuntimeError):
                     data = ak.read_parquet(filename, datasets=columns)
+
+
+class ParquetRowGroupTest(ArkoudaTest):
+    # files written with small row groups, whose columns are encoded and
+    # row groups decoded by several threads per file
+    server_args = [
+        "--ParquetMsg.ROWGROUPS=100",
+        "--ParquetMsg.readThreads=4",
+        "--ParquetMsg.writeThreads=4",
+        "--ParquetMsg.writeRowGroupBytes=8192",
+    ]
+
+    @classmethod
+    def setUpClass(cls):
+        super(ParquetRowGroupTest, cls).setUpClass()
+        ParquetRowGroupTest.par_test_base_tmp = "{}/par_io_test".format(os.getcwd())
+        io_util.get_directory(ParquetRowGroupTest.par_test_base_tmp)
+
+    def test_threaded_read(self):
+        rng = np.random.default_rng(3)
+        with tempfile.TemporaryDirectory(dir=ParquetRowGroupTest.par_test_base_tmp) as tmp_dirname:
+            frames = []
+            for i, n in enumerate([3001, 4567]):
+                floats = rng.uniform(-1, 1, n)
+                floats[::7] = np.nan
+                df = pd.DataFrame(
+                    {
+                        "ints": rng.integers(-(2**40), 2**40, n),
+                        "small": rng.integers(-(2**31), 2**31, n).astype(np.int32),
+                        "floats": floats,
+                        "strs": [f"str{x}" for x in rng.integers(0, 1000, n)],
+                    }
+                )
+                pq.write_table(
+                    pa.Table.from_pandas(df, preserve_index=False),
+                    f"{tmp_dirname}/threaded_{i}.parquet",
+                    row_group_size=50,
+                )
+                frames.append(df)
+            expected = pd.concat(frames, ignore_index=True)
+
+            ak_data = ak.read_parquet(f"{tmp_dirname}/threaded_*")
+            for col in ("ints", "small", "strs"):
+                self.assertListEqual(ak_data[col].to_list(), expected[col].to_list())
+            self.assertTrue(
+                np.allclose(ak_data["floats"].to_ndarray(), expected["floats"], equal_nan=True)
+            )
+
+            ints = ak.read_parquet(f"{tmp_dirname}/threaded_*", "ints")
+            self.assertListEqual(ints.to_list(), expected["ints"].to_list())
+
+    def test_threaded_write(self):
+        n = 1003
+        cols = {
+            "ints": ak.randint(-(2**40), 2**40, n, seed=1),
+            "uints": ak.randint(0, 2**63, n, dtype=ak.uint64, seed=2),
+            "floats": ak.randint(-1, 1, n, dtype=ak.float64, seed=3),
+            "bools": ak.randint(0, 2, n, dtype=ak.bool, seed=4),
+            "strs": ak.random_strings_uniform(0, 8, n, seed=5),
+            "segs": ak.SegArray(ak.arange(0, 2 * n, 2), ak.arange(2 * n)),
+        }
+        with tempfile.TemporaryDirectory(dir=ParquetRowGroupTest.par_test_base_tmp) as tmp_dirname:
+            ak.DataFrame(cols).to_parquet(f"{tmp_dirname}/threaded_write")
+            files = sorted(glob.glob(f"{tmp_dirname}/threaded_write*"))
+            self.assertGreater(sum(pq.ParquetFile(f).num_row_groups for f in files), len(files))
+
+            rd = ak.read_parquet(f"{tmp_dirname}/threaded_write*")
+            for k, v in cols.items():
+                self.assertListEqual(rd[k].to_list(), v.to_list())
+            # the buffered row groups are laid out like sequential ones
+            expected = pd.concat([pq.read_table(f).to_pandas() for f in files], ignore_index=True)
+            self.assertListEqual(expected["strs"].fillna("").to_list(), cols["strs"].to_list())
+            self.assertListEqual(expected["ints"].to_list(), cols["ints"].to_list())
+
+    def test_row_group_bytes(self):
+        # rows of about 500 bytes are cut into row groups of 8192 bytes,
+        # well below the 100 rows they would have otherwise
+        cols = {"ints": ak.arange(1000), "strs": ak.random_strings_uniform(495, 500, 1000, seed=6)}
+        with tempfile.TemporaryDirectory(dir=ParquetRowGroupTest.par_test_base_tmp) as tmp_dirname:
+            ak.DataFrame(cols).to_parquet(f"{tmp_dirname}/wide_write")
+            files = glob.glob(f"{tmp_dirname}/wide_write*")
+            for f in files:
+                meta = pq.ParquetFile(f).metadata
+                for r in range(meta.num_row_groups):
+                    self.assertLessEqual(meta.row_group(r).num_rows, 8192 // 500)
+
+            rd = ak.read_parquet(f"{tmp_dirname}/wide_write*")
+            for k, v in cols.items():
+                self.assertListEqual(rd[k].to_list(), v.to_list())
+
+    def test_string_write(self):
+        strs = ak.array([["", "a", "", "bcd" * 20, "\u00e9"][i % 5] for i in range(457)])
+        with tempfile.TemporaryDirectory(dir=ParquetRowGroupTest.par_test_base_tmp) as tmp_dirname:
+            strs.to_parquet(f"{tmp_dirname}/str_write", "strs")
+            ak.to_parquet({"strs": strs, "ints": ak.arange(strs.size)}, f"{tmp_dirname}/multi_write")
+            for prefix in ("str_write", "multi_write"):
+                files = glob.glob(f"{tmp_dirname}/{prefix}*")
+                self.assertGreater(sum(pq.ParquetFile(f).num_row_groups for f in files), len(files))
+                rd = ak.read_parquet(f"{tmp_dirname}/{prefix}*", "strs")
+                self.assertListEqual(rd.to_list(), strs.to_list())
+
+    def test_segarray_write(self):
+        # empty segments, including a run longer than a row group
+        lengths = [[0, 3, 0, 1, 5][i % 5] for i in range(200)] + [0] * 150 + [2] * 100
+        offsets = ak.array(np.cumsum([0] + lengths[:-1]))
+        n = sum(lengths)
+        seg_values = {
+            "ints": ak.arange(n),
+            "floats": ak.linspace(-1, 1, n),
+            "bools": ak.arange(n) % 3 == 0,
+            "strs": ak.array([["", "x", "yz"][i % 3] for i in range(n)]),
+        }
+        with tempfile.TemporaryDirectory(dir=ParquetRowGroupTest.par_test_base_tmp) as tmp_dirname:
+            df = ak.DataFrame({k: ak.SegArray(offsets, v) for k, v in seg_values.items()})
+            df.to_parquet(f"{tmp_dirname}/seg_multi")
+            rd = ak.read_parquet(f"{tmp_dirname}/seg_multi*")
+            for k in seg_values:
+                self.assertListEqual(rd[k].to_list(), df[k].to_list())
+
+            for k, v in seg_values.items():
+                seg = ak.SegArray(offsets, v)
+                seg.to_parquet(f"{tmp_dirname}/seg_{k}")
+                files = glob.glob(f"{tmp_dirname}/seg_{k}*")
+                self.assertGreater(sum(pq.ParquetFile(f).num_row_groups for f in files), len(files))
+                self.assertListEqual(ak.read_parquet(f"{tmp_dirname}/seg_{k}*").to_list(), seg.to_list())
+
+
+class ParquetReadModeChecks:
+    """
+    Reads that a test class runs against a server with a non-default Parquet
+    read mode, comparing every dataset with pyarrow's read of the same files
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        super().setUpClass()
+        cls.par_test_base_tmp = "{}/par_io_test".format(os.getcwd())
+        io_util.get_directory(cls.par_test_base_tmp)
+
+    def test_read_mode(self):
+        rng = np.random.default_rng(19)
+        with tempfile.TemporaryDirectory(dir=self.par_test_base_tmp) as tmp_dirname:
+            tables = []
+            for i, n in enumerate([977, 20, 1500]):
+                floats = rng.uniform(-1, 1, n)
+                floats[::11] = np.nan
+                table = pa.table(
+                    {
+                        "ints": pa.array(np.arange(n) + 10000 * i),
+                        "small": pa.array(rng.integers(0, 2**32, n).astype(np.uint32)),
+                        "floats": pa.array(floats),
+                        "strs": pa.array([None if j % 7 == 0 else f"s{j}" for j in range(n)]),
+                        "lists": pa.array([list(range(j % 4)) for j in range(n)]),
+                    }
+                )
+                pq.write_table(table, f"{tmp_dirname}/read_mode_{i}.parquet", row_group_size=128)
+                tables.append(table)
+            expected = pa.concat_tables(tables).to_pandas()
+            expected["strs"] = expected["strs"].fillna("")
+            fname = f"{tmp_dirname}/read_mode_*"
+
+            # twice, the second time from the cached files
+            for _ in range(2):
+                ak_data = ak.read_parquet(fname)
+                for col in ("ints", "small", "strs"):
+                    self.assertListEqual(ak_data[col].to_list(), expected[col].to_list())
+                self.assertTrue(
+                    np.allclose(ak_data["floats"].to_ndarray(), expected["floats"], equal_nan=True)
+                )
+                self.assertListEqual(
+                    ak_data["lists"].to_list(), [x.tolist() for x in expected["lists"]]
+                )
+
+            ints = ak.read_parquet(fname, "ints", filters={"ints": (10000, 10099)})
+            self.assertListEqual(ints.to_list(), list(range(10000, 10020)))
+
+            # a file rewritten in place is read again rather than from a
+            # stale mapping or buffer
+            pq.write_table(
+                pa.table({"ints": pa.array([5, 6, 7])}), f"{tmp_dirname}/read_mode_1.parquet"
+            )
+            ints = ak.read_parquet(f"{tmp_dirname}/read_mode_1.parquet", "ints")
+            self.assertListEqual(ints.to_list(), [5, 6, 7])
+
+
+class ParquetMemoryMapTest(ParquetReadModeChecks, ArkoudaTest):
+    server_args = ["--ParquetMsg.memoryMap=true"]
+
+
+class ParquetPreBufferTest(ParquetReadModeChecks, ArkoudaTest):
+    # small ranges so the column chunks are pre-buffered in several reads
+    server_args = [
+        "--ParquetMsg.preBuffer=true",
+        "--ParquetMsg.holeSizeLimit=64",
+        "--ParquetMsg.rangeSizeLimit=1024",
+    ]
+
+
+class ParquetWriteBufferChecks:
+    """
+    Writes that a test class runs against a server with non-default write
+    buffers, each file several buffers long, read back and compared
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        super().setUpClass()
+        cls.par_test_base_tmp = "{}/par_io_test".format(os.getcwd())
+        io_util.get_directory(cls.par_test_base_tmp)
+
+    def test_buffered_writes(self):
+        n = 5000
+        strs = ak.random_strings_uniform(0, 20, n, seed=18)
+        segs = ak.SegArray(ak.arange(0, 3 * n, 3), ak.arange(3 * n))
+        str_segs = ak.SegArray(ak.arange(0, 2 * n, 2), ak.random_strings_uniform(1, 6, 2 * n, seed=19))
+        cols = {
+            "ints": ak.randint(-(2**40), 2**40, n, seed=20),
+            "floats": ak.randint(-1, 1, n, dtype=ak.float64, seed=21),
+            "bools": ak.randint(0, 2, n, dtype=ak.bool, seed=22),
+            "strs": strs,
+            "segs": segs,
+        }
+        with tempfile.TemporaryDirectory(dir=self.par_test_base_tmp) as tmp_dirname:
+            ak.DataFrame(cols).to_parquet(f"{tmp_dirname}/multi")
+            rd = ak.read_parquet(f"{tmp_dirname}/multi*")
+            for k, v in cols.items():
+                self.assertListEqual(rd[k].to_list(), v.to_list())
+
+            strs.to_parquet(f"{tmp_dirname}/strs", "strs")
+            self.assertListEqual(ak.read_parquet(f"{tmp_dirname}/strs*").to_list(), strs.to_list())
+
+            for name, seg in (("segs", segs), ("str_segs", str_segs)):
+                seg.to_parquet(f"{tmp_dirname}/{name}")
+                self.assertListEqual(ak.read_parquet(f"{tmp_dirname}/{name}*").to_list(), seg.to_list())
+
+            cols["ints"].to_parquet(f"{tmp_dirname}/append", "ints")
+            cols["floats"].to_parquet(f"{tmp_dirname}/append", "floats", mode="append")
+            rd = ak.read_parquet(f"{tmp_dirname}/append*")
+            for k in ("ints", "floats"):
+                self.assertListEqual(rd[k].to_list(), cols[k].to_list())
+
+            # the files are complete for other readers too
+            for f in glob.glob(f"{tmp_dirname}/multi*") + glob.glob(f"{tmp_dirname}/append*"):
+                pq.read_table(f)
+
+
+class ParquetSmallWriteBufferTest(ParquetWriteBufferChecks, ArkoudaTest):
+    # a single small buffer, so writers fill it and wait for it to be
+    # written out many times per file
+    server_args = ["--ParquetMsg.writeBufferSize=4096", "--ParquetMsg.writeBuffers=1"]
+
+
+class ParquetUnbufferedWriteTest(ParquetWriteBufferChecks, ArkoudaTest):
+    # files written synchronously, without a background writer
+    server_args = ["--ParquetMsg.writeBuffers=0"]
+